@@ -8,39 +8,39 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <ctype.h>
+#include <stdint.h>
 #include "phone_forward.h"
 #include "dictionary.h"
 
 /**
- * Domyślna wartość hasha dla słowa pustego
+ * Początkowy rozmiar tablicy słownika
  */
-#define HASH_DEFAULT 1
+#define DICTIONARY_INITIAL_CAPACITY 16
 
 /**
- * Podstawa systemu pozycyjnego do hashowania
+ * Początkowa wartość hasha FNV-1a
  */
-#define HASH_BASE 41
+#define HASH_OFFSET UINT64_C(0xCBF29CE484222325)
 
 /**
- * Modulo do hashowania
+ * Mnożnik hasha FNV-1a
  */
-#define HASH_MOD 999999937
+#define HASH_PRIME UINT64_C(0x100000001B3)
 
 /**
- * Słownik reprezentuję jako listę par (klucz, wartość)
+ * Pole tablicy słownika - para (klucz, wartość)
  */
-struct Dictionary {
+struct DictionaryEntry {
     /**@{*/
 
-    unsigned long hash;
+    uint64_t hash;
     /**<
      * Hash identyfikatora w danym polu
      */
 
     char const *identifier;
     /**<
-     * Identyfikator w danym polu
+     * Identyfikator w danym polu, lub @c NULL, jeśli pole jest puste
      */
 
     struct PhoneForward *val;
@@ -48,63 +48,163 @@ struct Dictionary {
      * Baza numerów telefonów w danym polu
      */
 
-    struct Dictionary *next;
+    /**@}*/
+};
+
+/**
+ * Słownik reprezentuję jako tablicę z adresowaniem otwartym (Robin Hood) -
+ * element, który jest dalej od swojego miejsca, wypiera bliższy, więc długość
+ * wyszukiwania nie zależy od liczby baz.
+ */
+struct Dictionary {
+    /**@{*/
+
+    struct DictionaryEntry *entries;
+    /**<
+     * Tablica pól, rozmiaru będącego potęgą dwójki
+     */
+
+    size_t capacity;
     /**<
-     * Następny element listy
+     * Rozmiar tablicy @p entries
+     */
+
+    size_t count;
+    /**<
+     * Liczba niepustych pól
      */
 
     /**@}*/
 };
 
 /**
- * Hashuje podane słowo.
+ * Hashuje podane słowo (FNV-1a).
  * @param identifier – słowo do shashowania.
- * @return Hash podanego słowa, lub @c 0 jeśli to słowo to @c NULL.
+ * @return Hash podanego słowa.
  */
-unsigned long dictionaryHash(char const *identifier) {
-    unsigned long hash;
-    size_t i;
+uint64_t dictionaryHash(char const *identifier) {
+    uint64_t hash;
 
-    // Sprawdzam NULL-a
-    if (identifier == NULL) {
-        return 0;
+    // Przechodzę po słowie, bez dzielenia modulo
+    for (hash = HASH_OFFSET; *identifier != '\0'; identifier++) {
+        hash ^= (unsigned char) *identifier;
+        hash *= HASH_PRIME;
     }
+    return hash;
+}
+
+/**
+ * Wyznacza odległość pola od miejsca, w którym powinien być jego element.
+ * @param dictionary – wskaźnik na słownik;
+ * @param position – pozycja niepustego pola.
+ * @return Odległość od pozycji wyznaczonej przez hash.
+ */
+static size_t dictionaryDistance(struct Dictionary const *dictionary,
+                                 size_t position) {
+    return (position - (size_t) dictionary->entries[position].hash) &
+           (dictionary->capacity - 1);
+}
+
+/**
+ * Wstawia element do tablicy, w której jest wolne miejsce i nie ma elementu o
+ * tym samym identyfikatorze.
+ * @param dictionary – wskaźnik na słownik;
+ * @param entry – wstawiany element.
+ */
+static void dictionaryInsert(struct Dictionary *dictionary,
+                             struct DictionaryEntry entry) {
+    struct DictionaryEntry helper;
+    size_t position, distance, displaced;
+
+    position = (size_t) entry.hash & (dictionary->capacity - 1);
+    for (distance = 0;; distance++) {
+        // Wolne pole kończy wstawianie
+        if (dictionary->entries[position].identifier == NULL) {
+            dictionary->entries[position] = entry;
+            dictionary->count++;
+            return;
+        }
 
-    // Ustawiam wartości początkowe
-    hash = HASH_DEFAULT;
-    i = 0;
-
-    // Przechodzę po słowie
-    while (identifier[i] != '\0') {
-        hash *= HASH_BASE;
-
-        // Dodaję kolejną cyfrę do hasha
-        if (isdigit(identifier[i])) {
-            hash += identifier[i] - '0';
-        } else if ('A' <= identifier[i] && identifier[i] <= 'Z') {
-            hash += identifier[i] - 'A' + 10;
-        } else if ('a' <= identifier[i] && identifier[i] <= 'z') {
-            hash += identifier[i] - 'a' + 10 + 26;
+        /*
+         * Element bliżej swojego miejsca ustępuje wstawianemu, a dalej
+         * wstawiam wypchnięty element, zaczynając od jego odległości.
+         */
+        displaced = dictionaryDistance(dictionary, position);
+        if (displaced < distance) {
+            helper = dictionary->entries[position];
+            dictionary->entries[position] = entry;
+            entry = helper;
+            distance = displaced;
         }
-        hash %= HASH_MOD;
-        i++;
+        position = (position + 1) & (dictionary->capacity - 1);
+    }
+}
+
+/**
+ * Szuka pola z danym identyfikatorem.
+ * @param dictionary – wskaźnik na słownik;
+ * @param identifier – szukany identyfikator;
+ * @param hash – hash identyfikatora.
+ * @return Pozycja pola, lub rozmiar tablicy, jeśli go nie ma.
+ */
+static size_t dictionaryFind(struct Dictionary const *dictionary,
+                             char const *identifier, uint64_t hash) {
+    struct DictionaryEntry const *entry;
+    size_t position, distance;
+
+    position = (size_t) hash & (dictionary->capacity - 1);
+    for (distance = 0;; distance++) {
+        entry = dictionary->entries + position;
+
+        /*
+         * Element byłby przed każdym polem bliższym swojego miejsca niż on,
+         * więc takie pole kończy wyszukiwanie.
+         */
+        if (entry->identifier == NULL ||
+            dictionaryDistance(dictionary, position) < distance)
+            return dictionary->capacity;
+
+        // Porównuję hashe, żeby było szybciej
+        if (entry->hash == hash && strcmp(identifier, entry->identifier) == 0)
+            return position;
+        position = (position + 1) & (dictionary->capacity - 1);
     }
-    return hash;
 }
 
 /**
- * Tworzy nowy element listy.
- * @param hash – hash identyfikatora elementu do dodania
- * @param identifier – identyfikator nowego elementu listy;
- * @param val – wskaźnik na bazę do umieszczenia w danym miejscu
- * @param next – wskaźnik na następny element listy.
- * @return Wskaźnik na nowoutworzony element listy, lub @c NULL, jeśli nie udało
- *         się zaalokować pamięci.
+ * Zapewnia miejsce na nowy element, powiększając tablicę dwukrotnie, jeśli
+ * byłaby zapełniona w więcej niż trzech czwartych.
+ * @param dictionary – wskaźnik na słownik.
+ * @return Wartość @c true, jeśli jest miejsce na nowy element, lub @c false,
+ *         jeśli nie udało się zaalokować pamięci.
  */
-struct Dictionary *dictionatyCreateElem(unsigned long hash,
-                                        char const *identifier,
-                                        struct PhoneForward *val,
-                                        struct Dictionary *next) {
+static bool dictionaryReserve(struct Dictionary *dictionary) {
+    struct DictionaryEntry *oldEntries;
+    size_t i, oldCapacity;
+
+    if ((dictionary->count + 1) * 4 <= dictionary->capacity * 3)
+        return true;
+
+    oldEntries = dictionary->entries;
+    oldCapacity = dictionary->capacity;
+    dictionary->entries = calloc(2 * oldCapacity,
+                                 sizeof(struct DictionaryEntry));
+    if (dictionary->entries == NULL) {
+        dictionary->entries = oldEntries;
+        return false;
+    }
+
+    // Przeniesienie elementów do nowej tablicy
+    dictionary->capacity = 2 * oldCapacity;
+    dictionary->count = 0;
+    for (i = 0; i < oldCapacity; i++)
+        if (oldEntries[i].identifier != NULL)
+            dictionaryInsert(dictionary, oldEntries[i]);
+    free(oldEntries);
+    return true;
+}
+
+struct Dictionary *dictionaryCreate() {
     struct Dictionary *newDictionary;
 
     // Zaalokowanie nowej struktury
@@ -112,115 +212,109 @@ struct Dictionary *dictionatyCreateElem(unsigned long hash,
     if (newDictionary == NULL)
         return NULL;
 
-    // Ustawienie wartości
-    newDictionary->hash = hash;
-    newDictionary->identifier = identifier;
-    newDictionary->val = val;
-    newDictionary->next = next;
+    // Pusty słownik jest reprezentowany przez tablicę pustych pól
+    newDictionary->entries = calloc(DICTIONARY_INITIAL_CAPACITY,
+                                    sizeof(struct DictionaryEntry));
+    if (newDictionary->entries == NULL) {
+        free(newDictionary);
+        return NULL;
+    }
+    newDictionary->capacity = DICTIONARY_INITIAL_CAPACITY;
+    newDictionary->count = 0;
 
-    // Zwrócenie nowej struktury
     return newDictionary;
 }
 
-struct Dictionary *dictionaryCreate() {
-
-    // Pusty słownik jest reprezentowany przez pustą listę
-    return dictionatyCreateElem(0, NULL, NULL, NULL);
-}
-
 void dictionaryDestroy(struct Dictionary *dictionary) {
+    size_t i;
+
     if (dictionary == NULL)
         return;
 
-    // Zniszczenie następnego elementu
-    dictionaryDestroy(dictionary->next);
-
-    // Zwolnienie wartości w aktualnym elemencie
-    free((void *) dictionary->identifier);
-    phfwdDelete(dictionary->val);
+    // Zwolnienie wartości w niepustych polach
+    for (i = 0; i < dictionary->capacity; i++) {
+        if (dictionary->entries[i].identifier == NULL)
+            continue;
+        free((void *) dictionary->entries[i].identifier);
+        phfwdDelete(dictionary->entries[i].val);
+    }
 
-    // Zwolnienie aktulnego elementu
+    // Zwolnienie tablicy i słownika
+    free(dictionary->entries);
     free(dictionary);
 }
 
 struct PhoneForward *dictionaryGet(struct Dictionary *dictionary,
                                    char const *identifier) {
-    struct Dictionary *currentElem;
+    struct DictionaryEntry newEntry;
     char *newIdentifier;
-    struct PhoneForward *newBase;
-    unsigned long hash;
+    size_t position;
 
-    hash = dictionaryHash(identifier);
+    newEntry.hash = dictionaryHash(identifier);
 
     // Sprawdzenie, czy element o danym identyfikatrze już istnieje
-    currentElem = dictionary->next;
-    while (currentElem != NULL) {
+    position = dictionaryFind(dictionary, identifier, newEntry.hash);
+    if (position < dictionary->capacity)
+        return dictionary->entries[position].val;
 
-        // Porównuję hashe, żeby było szybciej
-        if (hash == currentElem->hash &&
-            strcmp(identifier, currentElem->identifier) == 0) {
-            // Zwrócenie elementu z pasującym identyfikatorem
-            return currentElem->val;
-        }
-        currentElem = currentElem->next;
-    }
+    // Zapewnienie miejsca na nowy element
+    if (!dictionaryReserve(dictionary))
+        return NULL;
 
     // Stworzenie kopii identyfikatora
     newIdentifier = malloc((strlen(identifier) + 1) * sizeof(char));
-    strcpy(newIdentifier, identifier);
     if (newIdentifier == NULL)
         return NULL;
+    strcpy(newIdentifier, identifier);
 
     // Stworzenie nowej bazy danych
-    newBase = phfwdNew();
-    if (newBase == NULL) {
-        free(newIdentifier);
-        return NULL;
-    }
-
-    // Stworzenie nowego elementu listy
-    currentElem =
-            dictionatyCreateElem(hash, newIdentifier, newBase, dictionary->next);
-    if (currentElem == NULL) {
+    newEntry.identifier = newIdentifier;
+    newEntry.val = phfwdNew();
+    if (newEntry.val == NULL) {
         free(newIdentifier);
-        phfwdDelete(newBase);
         return NULL;
     }
 
-    // Dodanie nowego elementu do listy
-    dictionary->next = currentElem;
+    // Dodanie nowego elementu do tablicy
+    dictionaryInsert(dictionary, newEntry);
 
     // Zwróecnie nowego elementu
-    return currentElem->val;
+    return newEntry.val;
 }
 
 bool dictionaryRemove(struct Dictionary *dictionary, char const *identifier,
                       struct PhoneForward **phoneForward) {
-    struct Dictionary *currentElem;
-    unsigned long hash;
-
-    hash = dictionaryHash(identifier);
+    struct DictionaryEntry *entry;
+    size_t position, next;
 
     // Przeszukanie bazy
-    while (dictionary->next != NULL) {
-
-        // Porównuję najpierw hashe, żeby było szybciej
-        if (hash == dictionary->next->hash &&
-            strcmp(identifier, dictionary->next->identifier) == 0) {
-            // Usunięcie elementu, jeśli został znaleziony
-            currentElem = dictionary->next;
-            dictionary->next = currentElem->next;
-            currentElem->next = NULL;
-            if (currentElem->val == *phoneForward)
-                *phoneForward = NULL;
-            dictionaryDestroy(currentElem);
-            return true;
-        }
+    position = dictionaryFind(dictionary, identifier,
+                              dictionaryHash(identifier));
 
-        // Sprawdzenie kolejnego elementu
-        dictionary = dictionary->next;
+    // W przypadku nieznalezienia elementu zwrócenie stosownej informacji
+    if (position == dictionary->capacity)
+        return false;
+
+    // Usunięcie elementu
+    entry = dictionary->entries + position;
+    if (entry->val == *phoneForward)
+        *phoneForward = NULL;
+    free((void *) entry->identifier);
+    phfwdDelete(entry->val);
+    dictionary->count--;
+
+    /*
+     * Przesunięcie kolejnych elementów, które nie są na swoich miejscach, o
+     * jedno pole wstecz - dzięki temu nie są potrzebne znaczniki usunięcia.
+     */
+    next = (position + 1) & (dictionary->capacity - 1);
+    while (dictionary->entries[next].identifier != NULL &&
+           dictionaryDistance(dictionary, next) > 0) {
+        dictionary->entries[position] = dictionary->entries[next];
+        position = next;
+        next = (next + 1) & (dictionary->capacity - 1);
     }
+    dictionary->entries[position].identifier = NULL;
 
-    // W przypadku nieznalezienia elementu zwrócenie stosownej informacji
-    return false;
+    return true;
 }
@@ -6,17 +6,258 @@
  * @date 27.05.2018
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <string.h>
 #include <stdio.h>
-#include <ctype.h>
+#include <stdlib.h>
+#include <errno.h>
+#include <unistd.h>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 #include "operation.h"
 #include "input_reader.h"
+#include "output_writer.h"
 #include "phone_forward_struct.h"
 
 /**
- * Początkowy rozmiar słów do których są wczytywane parametry operacji
+ * Rozmiar bloku wejścia wczytywanego naraz
+ */
+#define INPUT_BUFFER_SIZE (1 << 20)
+
+/**
+ * Początkowy rozmiar tablicy numerów operacji @ref GET_BATCH
+ */
+#define PARAMS_INITIAL_COUNT 4
+
+/**
+ * Klasa białych znaków (jak @c isspace w lokalizacji @c "C")
+ */
+#define CHARACTER_SPACE 1
+
+/**
+ * Klasa cyfr numeru - znaków od @ref FIRST_LETTER do @ref LAST_LETTER
+ */
+#define CHARACTER_NUMBER_DIGIT 2
+
+/**
+ * Klasa liter (jak @c isalpha w lokalizacji @c "C")
+ */
+#define CHARACTER_ALPHA 4
+
+/**
+ * Klasa znaków alfanumerycznych (jak @c isalnum w lokalizacji @c "C")
+ */
+#define CHARACTER_ALNUM 8
+
+/**
+ * Klasa znaków wnętrza komentarza, które nie mogą go kończyć - wszystkich
+ * poza @c $ i znakiem równym @c EOF po rzutowaniu na @c char
+ */
+#define CHARACTER_COMMENT 16
+
+/**
+ * Klasy znaków - suma bitowa stałych @c CHARACTER_* dla każdego bajtu
+ */
+static const unsigned char characterClass[256] = {
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 17, 17, 17, 17, 17, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        17, 16, 16, 16,  0, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        26, 26, 26, 26, 26, 26, 26, 26, 26, 26, 18, 18, 16, 16, 16, 16,
+        16, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 16, 16, 16, 16, 16,
+        16, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28,
+        28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 28, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+        16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,  0
+};
+
+/**
+ * Blok wejścia - znaki od @ref inputPosition do @ref inputEnd nie zostały
+ * jeszcze przetworzone
  */
-#define PARAM_INITIAL_SIZE 1
+static unsigned char inputBuffer[INPUT_BUFFER_SIZE];
+
+/**
+ * Pozycja następnego znaku do przetworzenia w @ref inputBuffer
+ */
+static size_t inputPosition;
+
+/**
+ * Liczba znaków wczytanych do @ref inputBuffer
+ */
+static size_t inputEnd;
+
+/**
+ * Informacja, czy został osiągnięty koniec wejścia
+ */
+static bool inputFinished;
+
+/**
+ * Funkcja wywoływana przed wczytaniem bloku zamiast opróżnienia bufora
+ * wyjścia, lub @c NULL
+ */
+static void (*inputFillCallback)(void *);
+
+/**
+ * Argument funkcji @ref inputFillCallback
+ */
+static void *inputFillArgument;
+
+/**
+ * @brief Wczytuje kolejny blok wejścia.
+ * Wczytuje tyle znaków, ile jest dostępnych (najwyżej
+ * @ref INPUT_BUFFER_SIZE), więc nie czeka na zapełnienie całego bloku.
+ * Wcześniej opróżnia bufor wyjścia (albo wywołuje funkcję ustawioną przez
+ * @ref inputReaderSetFillCallback), żeby przy pracy interaktywnej wyniki były
+ * widoczne, zanim program zacznie czekać na wejście. Błąd odczytu jest
+ * traktowany jak koniec wejścia.
+ * @return Wartość @c true, jeśli wczytano jakiś znak, lub wartość @c false,
+ *         jeśli wejście się skończyło.
+ */
+static bool inputReaderFill(void) {
+    ssize_t count;
+
+    if (inputFinished)
+        return false;
+    if (inputFillCallback != NULL)
+        inputFillCallback(inputFillArgument);
+    else
+        outputWriterFlush();
+    do {
+        count = read(STDIN_FILENO, inputBuffer, INPUT_BUFFER_SIZE);
+    } while (count < 0 && errno == EINTR);
+    if (count <= 0) {
+        inputFinished = true;
+        return false;
+    }
+    inputPosition = 0;
+    inputEnd = (size_t) count;
+    return true;
+}
+
+/**
+ * @brief Wczytuje znak.
+ * Działa jak @c getchar, ale na bloku @ref inputBuffer.
+ * @return Kolejny znak wejścia, lub @c EOF.
+ */
+static inline int inputReaderGetChar(void) {
+    if (inputPosition == inputEnd && !inputReaderFill())
+        return EOF;
+    return inputBuffer[inputPosition++];
+}
+
+/**
+ * @brief Zwraca znak na wejście.
+ * Działa jak @c ungetc - zwrócony znak zastępuje w bloku ostatnio wczytany.
+ * Tak jak @c ungetc, nic nie robi dla wartości @c EOF (także dla znaku typu
+ * @c char, który po rozszerzeniu do @c int jest jej równy).
+ * @param c – zwracany znak.
+ */
+static inline void inputReaderUngetChar(int c) {
+    if (c != EOF)
+        inputBuffer[--inputPosition] = (unsigned char) c;
+}
+
+/**
+ * @brief Sprawdza klasę znaku.
+ * @param c – sprawdzany znak;
+ * @param kind – klasa znaku, jedna ze stałych @c CHARACTER_*.
+ * @return Wartość @c true, jeśli znak należy do klasy, lub wartość @c false
+ *         w przeciwnym przypadku.
+ */
+static inline bool characterIs(int c, unsigned char kind) {
+    return (characterClass[(unsigned char) c] & kind) != 0;
+}
+
+#ifdef __SSE2__
+/**
+ * @brief Wyznacza maskę znaków klasy dla 16 znaków naraz.
+ * @param chunk – 16 kolejnych znaków wejścia;
+ * @param kind – jedna z klas @ref CHARACTER_SPACE,
+ *               @ref CHARACTER_NUMBER_DIGIT, lub @ref CHARACTER_COMMENT.
+ * @return Maska, której @c i-ty bit jest ustawiony, jeśli @c i-ty znak należy
+ *         do klasy.
+ */
+static inline unsigned characterMask(__m128i chunk, unsigned char kind) {
+    __m128i shifted, matched;
+
+    switch (kind) {
+        case CHARACTER_SPACE:
+            // Spacja, lub znak od '\t' do '\r'
+            shifted = _mm_sub_epi8(chunk, _mm_set1_epi8('\t'));
+            matched = _mm_or_si128(
+                    _mm_cmpeq_epi8(chunk, _mm_set1_epi8(' ')),
+                    _mm_cmpeq_epi8(_mm_min_epu8(shifted, _mm_set1_epi8(4)),
+                                   shifted));
+            break;
+        case CHARACTER_NUMBER_DIGIT:
+            // Znak od FIRST_LETTER do LAST_LETTER
+            shifted = _mm_sub_epi8(chunk, _mm_set1_epi8(FIRST_LETTER));
+            matched = _mm_cmpeq_epi8(
+                    _mm_min_epu8(shifted,
+                                 _mm_set1_epi8(LAST_LETTER - FIRST_LETTER)),
+                    shifted);
+            break;
+        default:
+            // Znak różny od '$' i od bajtu 0xFF
+            matched = _mm_andnot_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('$')),
+                                 _mm_cmpeq_epi8(chunk, _mm_set1_epi8(-1))),
+                    _mm_set1_epi8(-1));
+            break;
+    }
+    return (unsigned) _mm_movemask_epi8(matched);
+}
+#endif
+
+/**
+ * @brief Pomija znaki danej klasy.
+ * Przesuwa @ref inputPosition za najdłuższy ciąg znaków klasy @p kind w
+ * aktualnym bloku wejścia, bez wczytywania kolejnego bloku. Jeśli jest to
+ * możliwe, sprawdza po 16 znaków naraz.
+ * @param kind – jedna z klas @ref CHARACTER_SPACE,
+ *               @ref CHARACTER_NUMBER_DIGIT, @ref CHARACTER_ALNUM, lub
+ *               @ref CHARACTER_COMMENT.
+ * @return Liczba pominiętych znaków.
+ */
+static size_t inputReaderSkip(unsigned char kind) {
+    size_t start;
+#ifdef __SSE2__
+    unsigned mask;
+#endif
+
+    start = inputPosition;
+#ifdef __SSE2__
+    if (kind != CHARACTER_ALNUM) {
+        while (inputEnd - inputPosition >= 16) {
+            mask = characterMask(_mm_loadu_si128(
+                    (__m128i const *) (inputBuffer + inputPosition)), kind);
+            if (mask != 0xFFFF) {
+                // Pierwszy znak spoza klasy to najniższy zerowy bit maski
+                mask = ~mask;
+                while ((mask & 1) == 0) {
+                    mask >>= 1;
+                    inputPosition++;
+                }
+                return inputPosition - start;
+            }
+            inputPosition += 16;
+        }
+    }
+#endif
+    while (inputPosition < inputEnd &&
+           characterIs(inputBuffer[inputPosition], kind))
+        inputPosition++;
+    return inputPosition - start;
+}
 
 /**
  * @brief Sprawdza, czy dana cyfra jest dozwoloną cyfrą numeru telefonu.
@@ -26,19 +267,75 @@
  *         w przeciwnym przypadku 0.
  */
 int isNumberDigit(char c) {
-    if (FIRST_LETTER <= c && c <= LAST_LETTER)
-        return 1;
-    return 0;
+    return characterIs(c, CHARACTER_NUMBER_DIGIT);
+}
+
+/**
+ * @brief Czyta ciąg znaków parametru.
+ * Przepisuje z wejścia najdłuższy ciąg cyfr numeru (jeśli @p number ma
+ * wartość @c true), lub znaków alfanumerycznych (w przeciwnym przypadku),
+ * przeglądając blok wejścia bezpośrednio. Parametr jest zapisywany w bloku
+ * pamięci operacji, więc w typowym przypadku nie jest alokowana pamięć.
+ * @param[in, out] operation – operacja, w której bloku zapisywany jest
+ *                             parametr;
+ * @param[out] param – wskaźnik na zmienną, do której zostanie zapisane słowo
+ *                     zawierające wczytany parametr;
+ * @param[out] length – wskaźnik na zmienną, do której zostanie zapisana
+ *                      długość parametru;
+ * @param number – informacja, czy wczytywany jest numer;
+ * @param[in, out] inputCharacterNumber – wskaźnik na liczbę wczytanych znaków.
+ * @return Wartość @c true, jeśli wczytanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool readParameter(struct Operation *operation, char **param,
+                          size_t *length, bool number,
+                          int *inputCharacterNumber) {
+    char *destination;
+    size_t start, count, size;
+
+    *param = NULL;
+    size = 0;
+    do {
+        if (inputPosition == inputEnd && !inputReaderFill())
+            break;
+
+        // Przejście po pasujących znakach bloku
+        start = inputPosition;
+        count = inputReaderSkip(number ? CHARACTER_NUMBER_DIGIT
+                                       : CHARACTER_ALNUM);
+
+        // Dopisanie ich do parametru
+        destination = operationScratchReserve(operation, size, count);
+        if (destination == NULL)
+            return false;
+        memcpy(destination + size, inputBuffer + start, count);
+        size += count;
+        *inputCharacterNumber += (int) count;
+    } while (inputPosition == inputEnd);
+
+    // Ustawienie końca słowa
+    if (operationScratchReserve(operation, size, 0) == NULL)
+        return false;
+    *param = operationScratchCommit(operation, size);
+    *length = size;
+
+    // Znak kończący, równy EOF po rzutowaniu, jest tracony jak przy ungetc
+    if (inputPosition < inputEnd &&
+        (char) inputBuffer[inputPosition] == (char) EOF)
+        inputPosition++;
+    return true;
 }
 
 /**
  * @brief Czyta parametr będący numerem.
  * Wczytuje ze standardowego wejścia ciąg znaków składających się na
  * numer do pierwszego wystąpienia innego znaku.
- * @param[in] param – niezaalokowany wskaźnik na miejsce do wczytania parametru;
+ * @param[in, out] operation – operacja, w której bloku zapisywany jest
+ *                             parametr;
  * @param[out] param – słowo zawierające wczytany parametr, jeśli wczytanie się
- *                     powiodło, lub niezaalokowany wskaźnik, jeśli wczytanie
- *                     nie powiodło się;
+ *                     powiodło;
+ * @param[out] length – długość wczytanego parametru, jeśli wczytanie się
+ *                      powiodło;
  * @param[in] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych przed
  *                                   rozpoczęciem aktualnej operacji wczytywania;
  * @param[out] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych po
@@ -47,49 +344,23 @@ int isNumberDigit(char c) {
  *         błąd, wartość @ref PARSING_ERROR jeśli napotkano błąd wejścia, lub
  *         dowolną inną wartość jeśli udało się wczytać numer.
  */
-int readNumber(char **param, int *inputCharacterNumber) {
+int readNumber(struct Operation *operation, char **param, size_t *length,
+               int *inputCharacterNumber) {
     char c;
-    size_t sizeOfParam, paramFirstFreePlace;
 
     // Sprawdzenie, czy pierwszy znak się zgadza
-    c = (char) getchar();
+    c = (char) inputReaderGetChar();
     (*inputCharacterNumber)++;
     if (!isNumberDigit(c))
         return PARSING_ERROR;
 
     // Odłożenie pierwszego znaku spowrotem
-    ungetc(c, stdin);
+    inputReaderUngetChar(c);
     (*inputCharacterNumber)--;
 
-    // Przygotoanie parametru do wczytywania
-    sizeOfParam = PARAM_INITIAL_SIZE;
-    *param = malloc((sizeOfParam + 1) * sizeof(char));
-    if (*param == NULL)
-        return MEMORY_ERROR;
-    paramFirstFreePlace = 0;
-
     // Wczytywanie tak długo, jak mamy pasujące znaki
-    while (isNumberDigit(c = (char) getchar())) {
-        (*inputCharacterNumber)++;
-
-        // Zwiększenie parametru wejścia dwuktornie, jeśli zajdzie taka potrzeba
-        if (paramFirstFreePlace == sizeOfParam) {
-            sizeOfParam *= 2;
-            (*param) = realloc((*param), (sizeOfParam + 1) * sizeof(char));
-            if ((*param) == NULL) {
-                return MEMORY_ERROR;
-            }
-        }
-
-        // Ustawienie kolejnego znaku
-        (*param)[paramFirstFreePlace++] = c;
-    }
-
-    // Ustawienie końca słowa
-    (*param)[paramFirstFreePlace] = '\0';
-
-    // Zwrócenie pierwszwego niepoprawnego znaku
-    ungetc(c, stdin);
+    if (!readParameter(operation, param, length, true, inputCharacterNumber))
+        return MEMORY_ERROR;
 
     // Zakończenie sukcesem
     return -1;
@@ -99,10 +370,12 @@ int readNumber(char **param, int *inputCharacterNumber) {
  * @brief Czyta parametr będący identyfikatorem.
  * Wczytuje ze standardowego wejścia ciąg znaków składających się na
  * identyfikator do pierwszego wystąpienia innego znaku.
- * @param[in] param – niezaalokowany wskaźnik na miejsce do wczytania parametru;
+ * @param[in, out] operation – operacja, w której bloku zapisywany jest
+ *                             parametr;
  * @param[out] param – słowo zawierające wczytany parametr, jeśli wczytanie się
- *                     powiodło, lub niezaalokowany wskaźnik, jeśli wczytanie
- *                     nie powiodło się;
+ *                     powiodło;
+ * @param[out] length – długość wczytanego parametru, jeśli wczytanie się
+ *                      powiodło;
  * @param[in] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych przed
  *                                   rozpoczęciem aktualnej operacji wczytywania;
  * @param[out] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych po
@@ -111,57 +384,30 @@ int readNumber(char **param, int *inputCharacterNumber) {
  *         błąd, wartość @ref PARSING_ERROR jeśli napotkano błąd wejścia, lub
  *         dowolną inną wartość jeśli udało się wczytać numer.
  */
-int readIdentifier(char **param, int *inputCharacterNumber) {
+int readIdentifier(struct Operation *operation, char **param, size_t *length,
+                   int *inputCharacterNumber) {
     char c;
-    size_t sizeOfParam, paramFirstFreePlace;
 
-    c = (char) getchar();
+    c = (char) inputReaderGetChar();
     // Sprawdzenie, czy pierwszy znak się zgadza
     (*inputCharacterNumber)++;
-    if (!isalpha(c))
+    if (!characterIs(c, CHARACTER_ALPHA))
         return PARSING_ERROR;
 
     // Odłożenie pierwszego znaku spowrotem
-    ungetc(c, stdin);
+    inputReaderUngetChar(c);
     (*inputCharacterNumber)--;
 
-    // Przygotoanie parametru do wczytywania
-    sizeOfParam = PARAM_INITIAL_SIZE;
-    *param = malloc((sizeOfParam + 1) * sizeof(char));
-    if (*param == NULL)
-        return MEMORY_ERROR;
-    paramFirstFreePlace = 0;
-
     // Wczytywanie tak długo, jak mamy pasujące znaki
-    while (isalnum(c = (char) getchar())) {
-        (*inputCharacterNumber)++;
-
-        // Zwiększenie parametru wejścia dwuktornie, jeśli zajdzie taka potrzeba
-        if (paramFirstFreePlace == sizeOfParam) {
-            sizeOfParam *= 2;
-            (*param) = realloc((*param), (sizeOfParam + 1) * sizeof(char));
-            if ((*param) == NULL) {
-                return MEMORY_ERROR;
-            }
-        }
-
-        // Ustawienie kolejnego znaku
-        (*param)[paramFirstFreePlace++] = c;
-    }
-
-    // Ustawienie końca słowa
-    (*param)[paramFirstFreePlace] = '\0';
+    if (!readParameter(operation, param, length, false, inputCharacterNumber))
+        return MEMORY_ERROR;
 
     // NEW i DEL nie mogą być identyfikatormai
     if (strcmp("NEW", *param) == 0 || strcmp("DEL", *param) == 0) {
-        free(*param);
         (*inputCharacterNumber) -= 2;
         return PARSING_ERROR;
     }
 
-    // Zwrócenie pierwszwego niepoprawnego znaku
-    ungetc(c, stdin);
-
     // Zakończenie sukcesem
     return -1;
 }
@@ -182,7 +428,13 @@ int readIdentifier(char **param, int *inputCharacterNumber) {
 bool readNotImportatantAndLastIsEOF(char *c, int *inputCharacterNumber) {
     // Wczytuje białe znaki i komentarze
     (*inputCharacterNumber)++;
-    while (isspace(*c = (char) getchar()) || *c == '$') {
+    while (true) {
+        // Pomijam naraz białe znaki z aktualnego bloku
+        *inputCharacterNumber += (int) inputReaderSkip(CHARACTER_SPACE);
+        *c = (char) inputReaderGetChar();
+        if (!characterIs(*c, CHARACTER_SPACE) && *c != '$')
+            break;
+
         // Doliczam kolejny wczytany znak
         (*inputCharacterNumber)++;
 
@@ -191,10 +443,10 @@ bool readNotImportatantAndLastIsEOF(char *c, int *inputCharacterNumber) {
             continue;
 
         // Sprawdzam, czy własnie rozpoczyna się komentarz
-        if ((*c = (char) getchar()) != '$') {
+        if ((*c = (char) inputReaderGetChar()) != '$') {
 
             // Jeśli nie, to odkładam zabrany z wejścia znak spowrotem
-            ungetc(*c, stdin);
+            inputReaderUngetChar(*c);
             (*inputCharacterNumber)--;
 
             // I ustawiam aktualny znak na znak poprzedni
@@ -210,8 +462,11 @@ bool readNotImportatantAndLastIsEOF(char *c, int *inputCharacterNumber) {
         // Do czasu nie znalezienia końca komentarza szukam jego końca
         while (true) {
 
+            // Pomijam naraz znaki, które nie mogą kończyć komentarza
+            *inputCharacterNumber += (int) inputReaderSkip(CHARACTER_COMMENT);
+
             // Wczytuję kolejny znak
-            *c = (char) getchar();
+            *c = (char) inputReaderGetChar();
 
             // Doliczam kolejny wczytany znak
             (*inputCharacterNumber)++;
@@ -228,7 +483,7 @@ bool readNotImportatantAndLastIsEOF(char *c, int *inputCharacterNumber) {
              */
             if (*c == '$') {
                 // Wczytuję kolejny znak
-                *c = (char) getchar();
+                *c = (char) inputReaderGetChar();
 
                 // Doliczam kolejny wczytany znak
                 (*inputCharacterNumber)++;
@@ -247,6 +502,111 @@ bool readNotImportatantAndLastIsEOF(char *c, int *inputCharacterNumber) {
     return false;
 }
 
+/**
+ * @brief Dopisuje numer do operacji @ref GET_BATCH.
+ * @param[in, out] operation – operacja, do której tablicy numerów jest
+ *                             dopisywany numer;
+ * @param number – numer zapisany w bloku pamięci operacji.
+ * @return Wartość @c true, jeśli dopisanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować pamięci.
+ */
+bool addBatchParameter(struct Operation *operation, char *number) {
+    char **newParameters;
+    size_t newCapacity;
+
+    // Zwiększenie tablicy numerów dwukrotnie, jeśli zajdzie taka potrzeba
+    if (operation->parametersCount == operation->parametersCapacity) {
+        newCapacity = operation->parametersCapacity == 0
+                      ? PARAMS_INITIAL_COUNT
+                      : 2 * operation->parametersCapacity;
+        newParameters = realloc(operation->parameters,
+                                newCapacity * sizeof(char *));
+        if (newParameters == NULL)
+            return false;
+        operation->parameters = newParameters;
+        operation->parametersCapacity = newCapacity;
+    }
+
+    operation->parameters[operation->parametersCount++] = number;
+    return true;
+}
+
+/**
+ * @brief Wczytuje resztę operacji @ref GET_BATCH.
+ * Wczytuje kolejne numery aż do znaku @c ], który kończy grupę zapytań
+ * rozpoczętą znakiem @c [. Grupa musi zawierać co najmniej jeden numer.
+ * Błędny znak jest zgłaszany na swojej pozycji, a koniec pliku wewnątrz grupy
+ * jako @ref EOF_ERROR.
+ * @param[in, out] operation – wczytywana operacja, z ustawioną pozycją znaku
+ *                             @c [;
+ * @param[in] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych przed
+ *                                   rozpoczęciem aktualnej operacji wczytywania;
+ * @param[out] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych po
+ *                                    zanończeniu aktualnej operacji wczytywania.
+ */
+void readBatch(struct Operation *operation, int *inputCharacterNumber) {
+    char *number;
+    size_t length;
+    int markerSignNumber;
+    char c;
+
+    strcpy(operation->operationName, "[");
+    markerSignNumber = operation->firstSignNumber;
+    for (;;) {
+        /*
+         * Wczytanie białych znaków i komentarzy i sprawdzenie przypadku końca
+         * pliku.
+         */
+        if (readNotImportatantAndLastIsEOF(&c, inputCharacterNumber) ||
+            c == EOF) {
+            operation->typeOfOperation = EOF_ERROR;
+            return;
+        }
+
+        // Ustawienie ostatniego aktywnego znaku
+        operation->firstSignNumber = (*inputCharacterNumber);
+
+        // Znak kończący niepustą grupę
+        if (c == ']' && operation->parametersCount > 0)
+            break;
+
+        // Wszystkie parametry poza znakiem kończącym muszą być numerami
+        if (!isNumberDigit(c)) {
+            operation->typeOfOperation = PARSING_ERROR;
+            return;
+        }
+
+        // Zwracam pierwszy znak na wejście
+        (*inputCharacterNumber)--;
+        inputReaderUngetChar(c);
+
+        // Wczytanie kolejnego numeru
+        switch (readNumber(operation, &number, &length,
+                           inputCharacterNumber)) {
+            case MEMORY_ERROR:
+                operation->typeOfOperation = MEMORY_ERROR;
+                return;
+
+            case PARSING_ERROR:
+                operation->typeOfOperation = PARSING_ERROR;
+                operation->firstSignNumber = (*inputCharacterNumber);
+                return;
+
+            default:
+                // Wczytanie się powiodło
+                break;
+        }
+        if (!addBatchParameter(operation, number)) {
+            operation->typeOfOperation = MEMORY_ERROR;
+            return;
+        }
+    }
+
+    // Błędy wykonania są zgłaszane na pozycji znaku '['
+    operation->firstSignNumber = markerSignNumber;
+    operation->typeOfOperation = GET_BATCH;
+}
+
 /**
  * Wczytuje operator @c NEW, albo @c DEL.
  * @param[in] inputCharacterNumber – wskaźnik na liczbę znaków wczytanych przed
@@ -266,7 +626,7 @@ int readOperatorNEWorDEL(int *inputCharacterNumber) {
     // Wczytanie słowa
     for (i = 0; i < 3; i++) {
         (*inputCharacterNumber)++;
-        operationName[i] = (char) getchar();
+        operationName[i] = (char) inputReaderGetChar();
 
         /*
          * Znaki alfanumeryczne muszą zaczynać operator w tym miejscu, a nie
@@ -278,19 +638,19 @@ int readOperatorNEWorDEL(int *inputCharacterNumber) {
     }
 
 
-    if ((c = getchar()) == EOF) {
+    if ((c = inputReaderGetChar()) == EOF) {
         return EOF_ERROR;
     }
 
     // Sprawdzam, czy zakończyło się słowo kluczowe NEW/DEL
-    if (!isalnum(c)) {
+    if (!characterIs(c, CHARACTER_ALNUM)) {
         if (strcmp(operationName, "NEW") == 0) {
             if (c != EOF)
-                ungetc(c, stdin);
+                inputReaderUngetChar(c);
             return NEW_BASE;
         } else if (strcmp(operationName, "DEL") == 0) {
             if (c != EOF)
-                ungetc(c, stdin);
+                inputReaderUngetChar(c);
             return DEL_UNKNOWN;
         } else {
             return PARSING_ERROR;
@@ -299,15 +659,23 @@ int readOperatorNEWorDEL(int *inputCharacterNumber) {
     return PARSING_ERROR;
 }
 
+void inputReaderSetFillCallback(void (*callback)(void *), void *argument) {
+    inputFillCallback = callback;
+    inputFillArgument = argument;
+}
+
 bool inputReaderReadNextOperation(struct Operation *operation,
                                   int *inputCharacterNumber) {
     char c;
     char *firstParam, *secondParam;
+    size_t firstLength, secondLength;
     bool operatorRead;
 
     // Inicjalizacja wartości
     firstParam = NULL;
     secondParam = NULL;
+    firstLength = 0;
+    secondLength = 0;
     operatorRead = false;
 
 
@@ -336,8 +704,12 @@ bool inputReaderReadNextOperation(struct Operation *operation,
         strcpy(operation->operationName, "@");
         operatorRead = true;
         operation->typeOfOperation = NTRIV;
+    } else if (c == '[') {
+        // Grupa zapytań ma własną składnię
+        readBatch(operation, inputCharacterNumber);
+        return true;
     } else if (c == 'N' || c == 'D') {
-        ungetc(c, stdin);
+        inputReaderUngetChar(c);
         operation->firstSignNumber = (*inputCharacterNumber);
         (*inputCharacterNumber)--;
 
@@ -363,7 +735,7 @@ bool inputReaderReadNextOperation(struct Operation *operation,
 
     } else {
         (*inputCharacterNumber)--;
-        ungetc(c, stdin);
+        inputReaderUngetChar(c);
     }
 
     // Wczytanie białych znaków i komentarzy i sprawdzenie przypadku końca pliku
@@ -382,7 +754,7 @@ bool inputReaderReadNextOperation(struct Operation *operation,
     }
 
     // Sprawdzam, czy możeliwe jest, żeby wejście było dalej poprawne
-    if (!isNumberDigit(c) && !isalnum(c)) {
+    if (!isNumberDigit(c) && !characterIs(c, CHARACTER_ALNUM)) {
         operation->typeOfOperation = PARSING_ERROR;
         operation->firstSignNumber = (*inputCharacterNumber);
         return true;
@@ -390,14 +762,15 @@ bool inputReaderReadNextOperation(struct Operation *operation,
 
     // Zwracam pierwszy znak na wejście
     (*inputCharacterNumber)--;
-    ungetc(c, stdin);
+    inputReaderUngetChar(c);
 
     // Wczytuję pierwszy argument
     if (!operatorRead || operation->typeOfOperation == REV ||
         operation->typeOfOperation == DEL ||
         operation->typeOfOperation == NTRIV) {
         // Jeśli argument powinien być numerem
-        switch (readNumber(&firstParam, inputCharacterNumber)) {
+        switch (readNumber(operation, &firstParam, &firstLength,
+                           inputCharacterNumber)) {
             case MEMORY_ERROR:
                 operation->typeOfOperation = MEMORY_ERROR;
                 return true;
@@ -413,7 +786,8 @@ bool inputReaderReadNextOperation(struct Operation *operation,
         }
     } else {
         // Jeśli argument powinien być identyfikatorem
-        switch (readIdentifier(&firstParam, inputCharacterNumber)) {
+        switch (readIdentifier(operation, &firstParam, &firstLength,
+                               inputCharacterNumber)) {
             case MEMORY_ERROR:
                 operation->typeOfOperation = MEMORY_ERROR;
                 return true;
@@ -431,6 +805,7 @@ bool inputReaderReadNextOperation(struct Operation *operation,
 
     // Ustawiam pierwszy argument operacji
     operation->firstParameter = firstParam;
+    operation->firstParameterLength = firstLength;
 
     // Wszystkie operatry prefiksowe mają dokładnie jeden argument
     if (operatorRead) {
@@ -477,9 +852,10 @@ bool inputReaderReadNextOperation(struct Operation *operation,
 
     // Zwracam pierwszy znak na wejście
     (*inputCharacterNumber)--;
-    ungetc(c, stdin);
+    inputReaderUngetChar(c);
 
-    switch (readNumber(&secondParam, inputCharacterNumber)) {
+    switch (readNumber(operation, &secondParam, &secondLength,
+                       inputCharacterNumber)) {
         case MEMORY_ERROR:
             operation->typeOfOperation = MEMORY_ERROR;
             return true;
@@ -495,6 +871,7 @@ bool inputReaderReadNextOperation(struct Operation *operation,
     }
 
     operation->secondParameter = secondParam;
+    operation->secondParameterLength = secondLength;
 
     return true;
 }
\ No newline at end of file
@@ -32,4 +32,16 @@
 bool inputReaderReadNextOperation(struct Operation *operation,
                                   int *inputCharacterNumber);
 
+/**
+ * @brief Ustawia funkcję wywoływaną przed czekaniem na wejście.
+ * Domyślnie przed każdym wczytaniem bloku wejścia jest opróżniany bufor
+ * wyjścia. Jeśli wejście jest wczytywane w innym wątku niż wypisywane są
+ * wyniki, to należy to zastąpić - opróżnianie jest wtedy zadaniem wątku
+ * wypisującego.
+ * @param callback – funkcja wywoływana zamiast opróżnienia bufora wyjścia,
+ *                   lub @c NULL, co przywraca domyślne zachowanie;
+ * @param argument – argument przekazywany do @p callback.
+ */
+void inputReaderSetFillCallback(void (*callback)(void *), void *argument);
+
 #endif //TELEFONY_INPUT_PARSER_H
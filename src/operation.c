@@ -12,6 +12,7 @@
 #include "operation.h"
 #include "phone_forward.h"
 #include "dictionary.h"
+#include "output_writer.h"
 
 struct Operation *operationCreate() {
     struct Operation *newOperation;
@@ -25,24 +26,100 @@ struct Operation *operationCreate() {
     newOperation->typeOfOperation = MEMORY_ERROR;
     newOperation->firstSignNumber = 0;
     newOperation->firstParameter = NULL;
+    newOperation->firstParameterLength = 0;
     newOperation->secondParameter = NULL;
+    newOperation->secondParameterLength = 0;
+    newOperation->parameters = NULL;
+    newOperation->parametersCount = 0;
+    newOperation->parametersCapacity = 0;
+    newOperation->scratch = NULL;
+    newOperation->scratchUsed = 0;
+    newOperation->deferredOutput = false;
+    newOperation->output = NULL;
+    newOperation->outputUsed = 0;
+    newOperation->outputCapacity = 0;
     strcpy(newOperation->operationName, "");
 
     // Zwrócenie nowej struktury
     return newOperation;
 }
 
+/**
+ * @brief Zwalnia bloki pamięci na parametry.
+ * @param scratch – wskaźnik na pierwszy zwalniany blok, lub @c NULL.
+ */
+void operationFreeScratch(struct OperationScratch *scratch) {
+    struct OperationScratch *previous;
+
+    while (scratch != NULL) {
+        previous = scratch->previous;
+        free(scratch);
+        scratch = previous;
+    }
+}
+
+char *operationScratchReserve(struct Operation *operation, size_t length,
+                              size_t extra) {
+    struct OperationScratch *newScratch;
+    size_t required, capacity;
+
+    // Sprawdzenie, czy parametr mieści się w aktualnym bloku
+    required = length + extra + 1;
+    if (operation->scratch != NULL &&
+        operation->scratch->capacity - operation->scratchUsed >= required)
+        return operation->scratch->data + operation->scratchUsed;
+
+    // Utworzenie nowego bloku co najmniej dwukrotnie większego
+    capacity = OPERATION_SCRATCH_INITIAL_SIZE;
+    if (operation->scratch != NULL)
+        capacity = 2 * operation->scratch->capacity;
+    if (capacity < required)
+        capacity = required;
+    newScratch = malloc(sizeof(struct OperationScratch) +
+                        capacity * sizeof(char));
+    if (newScratch == NULL)
+        return NULL;
+    newScratch->capacity = capacity;
+
+    // Przeniesienie wczytywanego parametru, poprzednie zostają w starym bloku
+    if (length > 0)
+        memcpy(newScratch->data,
+               operation->scratch->data + operation->scratchUsed, length);
+    newScratch->previous = operation->scratch;
+    operation->scratch = newScratch;
+    operation->scratchUsed = 0;
+
+    return newScratch->data;
+}
+
+char *operationScratchCommit(struct Operation *operation, size_t length) {
+    char *parameter;
+
+    parameter = operation->scratch->data + operation->scratchUsed;
+    parameter[length] = '\0';
+    operation->scratchUsed += length + 1;
+
+    return parameter;
+}
+
 void operationClean(struct Operation *operation) {
 
-    // Zwolnienie parametrów
-    free(operation->firstParameter);
-    free(operation->secondParameter);
+    // Zwolnienie poprzednich bloków, ostatni zostaje do ponownego użycia
+    if (operation->scratch != NULL) {
+        operationFreeScratch(operation->scratch->previous);
+        operation->scratch->previous = NULL;
+    }
+    operation->scratchUsed = 0;
+    operation->parametersCount = 0;
+    operation->outputUsed = 0;
 
     // Ustawienie domyślnych wartości parametrów
     operation->typeOfOperation = MEMORY_ERROR;
     operation->firstSignNumber = 0;
     operation->firstParameter = NULL;
+    operation->firstParameterLength = 0;
     operation->secondParameter = NULL;
+    operation->secondParameterLength = 0;
     strcpy(operation->operationName, "");
 }
 
@@ -53,21 +130,88 @@ void operationDestroy(struct Operation *operation) {
         return;
 
     // Zwolnienie parametrów
-    free(operation->firstParameter);
-    free(operation->secondParameter);
+    operationFreeScratch(operation->scratch);
+    free(operation->parameters);
+    free(operation->output);
     strcpy(operation->operationName, "");
 
     // Zwolnienie struktury
     free(operation);
 }
 
+/**
+ * @brief Wypisuje wiersz wyniku operacji.
+ * Jeśli operacja ma ustawione @p deferredOutput, to dopisuje wiersz do jej
+ * wyników @p output, a w przeciwnym przypadku wypisuje go przez
+ * @ref outputWriterWriteLine.
+ * @param[in, out] operation – wskaźnik na wykonywaną operację;
+ * @param string – wskaźnik na wypisywany napis.
+ * @return Wartość @c true, jeśli wypisanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool operationWriteLine(struct Operation *operation,
+                               char const *string) {
+    size_t length, capacity;
+    char *newOutput;
+
+    if (!operation->deferredOutput) {
+        outputWriterWriteLine(string);
+        return true;
+    }
+
+    // Zwiększenie bufora wyników dwukrotnie, jeśli zajdzie taka potrzeba
+    length = strlen(string);
+    if (operation->outputCapacity - operation->outputUsed < length + 1) {
+        capacity = operation->outputCapacity == 0
+                   ? OPERATION_OUTPUT_INITIAL_SIZE
+                   : 2 * operation->outputCapacity;
+        if (capacity < operation->outputUsed + length + 1)
+            capacity = operation->outputUsed + length + 1;
+        newOutput = realloc(operation->output, capacity * sizeof(char));
+        if (newOutput == NULL)
+            return false;
+        operation->output = newOutput;
+        operation->outputCapacity = capacity;
+    }
+
+    memcpy(operation->output + operation->outputUsed, string, length);
+    operation->output[operation->outputUsed + length] = '\n';
+    operation->outputUsed += length + 1;
+    return true;
+}
+
+/**
+ * @brief Wypisuje numery będące wynikiem operacji.
+ * Wypisuje kolejne numery z @p numbers, każdy w osobnym wierszu, przez
+ * @ref operationWriteLine.
+ * @param[in, out] operation – wskaźnik na wykonywaną operację;
+ * @param numbers – wskaźnik na wypisywane numery.
+ * @return Wartość @c true, jeśli wypisanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować pamięci.
+ */
+static bool operationWriteNumbers(struct Operation *operation,
+                                  struct PhoneNumbers const *numbers) {
+    char const *number;
+    size_t i;
+
+    i = 0;
+    while ((number = phnumGet(numbers, i)) != NULL) {
+        if (!operationWriteLine(operation, number))
+            return false;
+        i++;
+    }
+    return true;
+}
+
 int operationExecute(struct Operation *operation,
                      struct PhoneForward **phoneForward,
-                     struct Dictionary *dictionary) {
+                     struct Dictionary *dictionary,
+                     struct PhoneForwardPool *pool) {
     struct PhoneForward *helper;
     struct PhoneNumbers const *output;
-    size_t i, len;
-    char const *number;
+    size_t len;
+    char result[24];
+    bool written;
 
     /*
      * Poprawność danych - numerów i identyfikatorów jest już sprawdzona w
@@ -110,8 +254,10 @@ int operationExecute(struct Operation *operation,
             /*
              * Dodanie przekierowania
              */
-            if (!phfwdAdd(*phoneForward, operation->firstParameter,
-                          operation->secondParameter))
+            if (!phfwdAddLength(*phoneForward, operation->firstParameter,
+                                operation->firstParameterLength,
+                                operation->secondParameter,
+                                operation->secondParameterLength))
                 return OPERATION_ERROR;
 
             break;
@@ -127,7 +273,8 @@ int operationExecute(struct Operation *operation,
             /*
              * Znalezienie przekierowania
              */
-            output = phfwdGet(*phoneForward, operation->firstParameter);
+            output = phfwdGetLength(*phoneForward, operation->firstParameter,
+                                    operation->firstParameterLength);
 
             // Sprawdzenie, czy wynik jest zaalokowany
             if (output == NULL)
@@ -138,12 +285,37 @@ int operationExecute(struct Operation *operation,
                 return OPERATION_ERROR;
 
             // Wypisanie szukanych numerów
-            i = 0;
-            while ((number = phnumGet(output, i)) != NULL) {
-                printf("%s\n", number);
-                i++;
+            written = operationWriteNumbers(operation, output);
+            phnumDelete(output);
+            if (!written)
+                return MEMORY_ERROR;
+
+            break;
+        case GET_BATCH:
+
+            /*
+             * Sprawdzenie istnienia aktualnej bazy
+             */
+            if (*phoneForward == NULL) {
+                return OPERATION_ERROR;
             }
+
+            /*
+             * Znalezienie przekierowań wszystkich numerów naraz
+             */
+            output = phfwdGetBatch(*phoneForward,
+                                   (char const *const *) operation->parameters,
+                                   operation->parametersCount);
+
+            // Sprawdzenie, czy wynik jest zaalokowany
+            if (output == NULL)
+                return MEMORY_ERROR;
+
+            // Wypisanie szukanych numerów w kolejności zapytań
+            written = operationWriteNumbers(operation, output);
             phnumDelete(output);
+            if (!written)
+                return MEMORY_ERROR;
 
             break;
         case REV:
@@ -169,12 +341,10 @@ int operationExecute(struct Operation *operation,
                 return OPERATION_ERROR;
 
             // Wypisanie szukanych numerów
-            i = 0;
-            while ((number = phnumGet(output, i)) != NULL) {
-                printf("%s\n", number);
-                i++;
-            }
+            written = operationWriteNumbers(operation, output);
             phnumDelete(output);
+            if (!written)
+                return MEMORY_ERROR;
 
             break;
         case DEL:
@@ -200,15 +370,19 @@ int operationExecute(struct Operation *operation,
             }
 
             // Ustawienie parametru len
-            len = strlen(operation->firstParameter);
+            len = operation->firstParameterLength;
             if (len > 12)
                 len -= 12;
             else
                 len = 0;
 
             // Wykonanie operacji i wypisanie wyniku
-            printf("%zu\n", phfwdNonTrivialCount(
-                    *phoneForward, operation->firstParameter, len));
+            snprintf(result, sizeof(result), "%zu",
+                     phfwdNonTrivialCountParallel(
+                             *phoneForward, operation->firstParameter, len,
+                             pool));
+            if (!operationWriteLine(operation, result))
+                return MEMORY_ERROR;
 
             break;
         default:
@@ -222,4 +396,39 @@ int operationExecute(struct Operation *operation,
     }
 
     return OPERATION_SUCCESS;
-}
\ No newline at end of file
+}
+
+void operationPrintError(struct Operation *operation, int result) {
+    // Wypisanie wyników poprzednich operacji przed komunikatem
+    outputWriterFlush();
+
+    switch (result) {
+
+        // Napodkany przedwcześnie EOF
+        case EOF_ERROR:
+            fprintf(stderr, "ERROR EOF\n");
+            break;
+
+        // Błąd wykonania operacji
+        case OPERATION_ERROR:
+            fprintf(stderr, "ERROR %s %d\n", operation->operationName,
+                    operation->firstSignNumber);
+            break;
+
+        // Błąd parsowania operacji wejścia
+        case PARSING_ERROR:
+            fprintf(stderr, "ERROR %d\n", operation->firstSignNumber);
+            break;
+
+        // Błąd pamięci
+        case MEMORY_ERROR:
+            fprintf(stderr, "ERROR memory error\n");
+            break;
+
+        // Nieznany błąd
+        default:
+            // Informacja o nieznanym błędzie
+            fprintf(stderr, "ERROR unknown error\n");
+            break;
+    }
+}
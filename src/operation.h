@@ -9,6 +9,8 @@
 #ifndef TELEFONY_INPUT_OPERATION_H
 #define TELEFONY_INPUT_OPERATION_H
 
+#include <stddef.h>
+#include <stdbool.h>
 #include "phone_forward.h"
 #include "dictionary.h"
 
@@ -77,6 +79,47 @@
  */
 #define NTRIV 12
 
+/**
+ * Kod operacji wypisania przekierowań z wielu podanych numerów.
+ */
+#define GET_BATCH 13
+
+/**
+ * Początkowy rozmiar bloku pamięci na parametry operacji
+ */
+#define OPERATION_SCRATCH_INITIAL_SIZE 256
+
+/**
+ * Początkowy rozmiar bufora wyników operacji zapisywanych do wypisania później
+ */
+#define OPERATION_OUTPUT_INITIAL_SIZE 64
+
+/**
+ * Blok pamięci, w którym są zapisywane kolejno parametry operacji.
+ */
+struct OperationScratch {
+
+    /**@{*/
+
+    struct OperationScratch *previous;
+    /**<
+     * Poprzedni, mniejszy blok, w którym mogą być jeszcze parametry aktualnej
+     * operacji, lub @c NULL.
+     */
+
+    size_t capacity;
+    /**<
+     * Liczba znaków, które mieszczą się w bloku.
+     */
+
+    char data[];
+    /**<
+     * Znaki parametrów, każdy zakończony znakiem @c '\0'.
+     */
+
+    /**@}*/
+};
+
 /**
  * Struktura przechowująca wszystkie informacje o danej operacji.
  */
@@ -96,7 +139,9 @@ struct Operation {
      *  - @ref ADD;
      *  - @ref GET;
      *  - @ref REV;
-     *  - @ref DEL.
+     *  - @ref DEL;
+     *  - @ref NTRIV;
+     *  - @ref GET_BATCH.
      */
 
     int firstSignNumber;
@@ -106,13 +151,73 @@ struct Operation {
 
     char *firstParameter;
     /**<
-     * Pierwszy parametr operacji
+     * Pierwszy parametr operacji, wskazujący na blok @p scratch
+     */
+
+    size_t firstParameterLength;
+    /**<
+     * Długość pierwszego parametru operacji
      */
 
     char *secondParameter;
     /**<
-     * Drugi parametr operacji. Jeśli operacja jest jednoargumentowa, to ma
-     * wartość @c NULL.
+     * Drugi parametr operacji, wskazujący na blok @p scratch. Jeśli operacja
+     * jest jednoargumentowa, to ma wartość @c NULL.
+     */
+
+    size_t secondParameterLength;
+    /**<
+     * Długość drugiego parametru operacji
+     */
+
+    char **parameters;
+    /**<
+     * Tablica numerów operacji @ref GET_BATCH, wskazujących na blok
+     * @p scratch. Jest zachowywana pomiędzy kolejnymi operacjami.
+     */
+
+    size_t parametersCount;
+    /**<
+     * Liczba numerów w tablicy @p parameters.
+     */
+
+    size_t parametersCapacity;
+    /**<
+     * Rozmiar tablicy @p parameters.
+     */
+
+    struct OperationScratch *scratch;
+    /**<
+     * Aktualny blok pamięci na parametry, lub @c NULL. Jest zachowywany
+     * pomiędzy kolejnymi operacjami, więc wczytywanie parametrów w typowym
+     * przypadku nie alokuje pamięci.
+     */
+
+    size_t scratchUsed;
+    /**<
+     * Liczba zajętych znaków bloku @p scratch.
+     */
+
+    bool deferredOutput;
+    /**<
+     * Informacja, czy wyniki operacji są zapisywane w @p output zamiast
+     * wypisywane. Nie jest zmieniana przez @ref operationClean.
+     */
+
+    char *output;
+    /**<
+     * Wyniki operacji do wypisania później, jeśli @p deferredOutput ma wartość
+     * @c true. Bufor jest zachowywany pomiędzy kolejnymi operacjami.
+     */
+
+    size_t outputUsed;
+    /**<
+     * Liczba znaków wyników w @p output.
+     */
+
+    size_t outputCapacity;
+    /**<
+     * Rozmiar bufora @p output.
      */
 
     char operationName[4];
@@ -143,7 +248,8 @@ void operationDestroy(struct Operation *operation);
 /**
  * @brief Czyści operation z danych.
  * Usuwa użyte już z @p operation ustawiając parametry na domyślne (takie jak
- * po @ref operationCreate).
+ * po @ref operationCreate). Zachowuje ostatni blok pamięci na parametry i
+ * tablicę numerów, żeby mogły zostać użyte przez kolejną operację.
  * @param[in] operation – wskaźnik na strukturę z informacjami o operacji,
  *                        których należy się pozbyć;
  * @param[out] operation – wskaźnik na strukturę z domyślnymi informacjami o
@@ -151,6 +257,32 @@ void operationDestroy(struct Operation *operation);
  */
 void operationClean(struct Operation *operation);
 
+/**
+ * @brief Zapewnia miejsce na parametr.
+ * Zapewnia, że w bloku @p scratch po zajętych znakach mieści się
+ * @p length + @p extra + 1 znaków. Jeśli nie, to tworzy nowy, większy blok i
+ * przepisuje do niego @p length znaków właśnie wczytywanego parametru.
+ * Parametry zapisane już wcześniej w poprzednim bloku pozostają poprawne.
+ * @param[in, out] operation – wskaźnik na operację;
+ * @param length – liczba znaków właśnie wczytywanego parametru;
+ * @param extra – liczba znaków, które zostaną do niego dopisane.
+ * @return Wskaźnik na początek wczytywanego parametru, lub @c NULL, jeśli nie
+ *         udało się zaalokować pamięci.
+ */
+char *operationScratchReserve(struct Operation *operation, size_t length,
+                              size_t extra);
+
+/**
+ * @brief Kończy parametr.
+ * Kończy znakiem @c '\0' parametr o długości @p length zapisany po zajętych
+ * znakach bloku @p scratch (w miejscu zapewnionym przez
+ * @ref operationScratchReserve) i oznacza go jako zajęty.
+ * @param[in, out] operation – wskaźnik na operację;
+ * @param length – długość parametru.
+ * @return Wskaźnik na parametr.
+ */
+char *operationScratchCommit(struct Operation *operation, size_t length);
+
 /**
  * @brief Wykonuje operacje, lub zwraca informację o błędzie.
  * Sprawdza poprawność argumentów operacji podanej w @p operation i możliwości
@@ -159,7 +291,10 @@ void operationClean(struct Operation *operation);
  * @param operation – wskaźnik na strukturę z informacjami o operacji;
  * @param phoneForward – wskaźnik na wskaźnik na bazę danych, która jest
  *                       aktualnie aktywna w programie;
- * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań.
+ * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań,
+ *                     który może mieć wartość @c NULL dla operacji innych niż
+ *                     @ref NEW_BASE i @ref DEL_BASE;
+ * @param pool – pula wątków używanych przez operację @c NTRIV, lub @c NULL.
  * @return Wartość @ref OPERATION_SUCCESS, jeśli wykonanie powiodło się, wartość
  *         @ref OPERATION_ERROR jeśli się nie powiodło z powodu błędu operacji,
  *         wartość @c MEMORY_ERROR jeśli wystąpił błąd alokacji pamięci, lub
@@ -168,6 +303,17 @@ void operationClean(struct Operation *operation);
  */
 int operationExecute(struct Operation *operation,
                      struct PhoneForward **phoneForward,
-                     struct Dictionary *dictionary);
+                     struct Dictionary *dictionary,
+                     struct PhoneForwardPool *pool);
+
+/**
+ * @brief Wypisuje komunikat o błędzie operacji.
+ * Opróżnia bufor wyjścia, a następnie wypisuje na standardowe wyjście
+ * diagnostyczne komunikat odpowiadający wynikowi @ref operationExecute.
+ * @param operation – wskaźnik na operację, która się nie powiodła;
+ * @param result – wynik @ref operationExecute różny od
+ *                 @ref OPERATION_SUCCESS.
+ */
+void operationPrintError(struct Operation *operation, int result);
 
 #endif //TELEFONY_INPUT_OPERATION_H
@@ -0,0 +1,124 @@
+/** @file
+ * Implementacja buforowanego wypisywania wyników operacji z interfejsem w
+ * @ref output_writer.h
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+#include "output_writer.h"
+
+/**
+ * Rozmiar bufora wyjścia
+ */
+#define OUTPUT_BUFFER_SIZE (1 << 20)
+
+/**
+ * Bufor wyjścia - znaki, które nie zostały jeszcze wypisane
+ */
+static char outputBuffer[OUTPUT_BUFFER_SIZE];
+
+/**
+ * Liczba znaków w @ref outputBuffer
+ */
+static size_t outputUsed;
+
+/**
+ * @brief Wypisuje fragmenty na standardowe wyjście.
+ * Wywołuje @c writev tak długo, aż wszystkie fragmenty zostaną wypisane.
+ * Błąd zapisu kończy wypisywanie, tak jak przy @c printf wyniki są wtedy
+ * tracone.
+ * @param[in, out] vector – tablica wypisywanych fragmentów, która jest
+ *                          modyfikowana;
+ * @param count – liczba fragmentów.
+ */
+static void outputWriterWriteAll(struct iovec *vector, int count) {
+    ssize_t written;
+    size_t done;
+
+    while (count > 0) {
+        written = writev(STDOUT_FILENO, vector, count);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+
+        // Pominięcie fragmentów wypisanych w całości
+        done = (size_t) written;
+        while (count > 0 && done >= vector->iov_len) {
+            done -= vector->iov_len;
+            vector++;
+            count--;
+        }
+
+        // Przesunięcie początku fragmentu wypisanego w części
+        if (count > 0) {
+            vector->iov_base = (char *) vector->iov_base + done;
+            vector->iov_len -= done;
+        }
+    }
+}
+
+/**
+ * @brief Wypisuje bufor razem z napisem.
+ * Pomocnicza do @ref outputWriterWrite i @ref outputWriterWriteLine, gdy
+ * napis nie mieści się w buforze. Wszystko jest wypisywane jednym wywołaniem
+ * @c writev, bez przepisywania napisu.
+ * @param string – wskaźnik na wypisywane znaki;
+ * @param length – liczba wypisywanych znaków;
+ * @param newLine – informacja, czy po napisie należy wypisać znak nowej linii.
+ */
+static void outputWriterWriteThrough(char const *string, size_t length,
+                                     bool newLine) {
+    struct iovec vector[3];
+
+    vector[0].iov_base = outputBuffer;
+    vector[0].iov_len = outputUsed;
+    vector[1].iov_base = (char *) string;
+    vector[1].iov_len = length;
+    vector[2].iov_base = "\n";
+    vector[2].iov_len = 1;
+    outputWriterWriteAll(vector, newLine ? 3 : 2);
+    outputUsed = 0;
+}
+
+void outputWriterWrite(char const *string, size_t length) {
+    if (length > OUTPUT_BUFFER_SIZE - outputUsed) {
+        outputWriterWriteThrough(string, length, false);
+        return;
+    }
+    memcpy(outputBuffer + outputUsed, string, length);
+    outputUsed += length;
+}
+
+void outputWriterWriteLine(char const *string) {
+    size_t length;
+
+    length = strlen(string);
+    if (length >= OUTPUT_BUFFER_SIZE - outputUsed) {
+        outputWriterWriteThrough(string, length, true);
+        return;
+    }
+    memcpy(outputBuffer + outputUsed, string, length);
+    outputBuffer[outputUsed + length] = '\n';
+    outputUsed += length + 1;
+}
+
+void outputWriterFlush(void) {
+    struct iovec vector;
+
+    if (outputUsed == 0)
+        return;
+    vector.iov_base = outputBuffer;
+    vector.iov_len = outputUsed;
+    outputWriterWriteAll(&vector, 1);
+    outputUsed = 0;
+}
@@ -0,0 +1,39 @@
+/** @file
+ * Interfejs buforowanego wypisywania wyników operacji z implementacją w
+ * @ref output_writer.c
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#ifndef TELEFONY_OUTPUT_WRITER_H
+#define TELEFONY_OUTPUT_WRITER_H
+
+#include <stddef.h>
+
+/**
+ * @brief Wypisuje napis.
+ * Dopisuje @p length znaków napisu @p string do bufora wyjścia. Jeśli się w
+ * nim nie mieszczą, to wypisuje bufor razem z napisem.
+ * @param string – wskaźnik na wypisywane znaki;
+ * @param length – liczba wypisywanych znaków.
+ */
+void outputWriterWrite(char const *string, size_t length);
+
+/**
+ * @brief Wypisuje wiersz.
+ * Działa jak @ref outputWriterWrite dla napisu zakończonego znakiem
+ * @c '\0', do którego dopisuje znak nowej linii.
+ * @param string – wskaźnik na wypisywany napis.
+ */
+void outputWriterWriteLine(char const *string);
+
+/**
+ * @brief Opróżnia bufor wyjścia.
+ * Wypisuje wszystkie znaki z bufora. Należy ją wywołać przed oczekiwaniem na
+ * wejście, przed wypisaniem komunikatu o błędzie i przed zakończeniem
+ * programu.
+ */
+void outputWriterFlush(void);
+
+#endif //TELEFONY_OUTPUT_WRITER_H
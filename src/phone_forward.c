@@ -14,6 +14,7 @@
 #include "phone_forward_remove.h"
 #include "phone_forward_reverse.h"
 #include "phone_forward_non_trivial_count.h"
+#include "phone_forward_pool.h"
 
 struct PhoneForward *phfwdNew(void) {
     return phoneForwardCreate();
@@ -27,6 +28,11 @@ bool phfwdAdd(struct PhoneForward *pf, char const *num1, char const *num2) {
     return phoneForwardAdd(pf, num1, num2);
 }
 
+bool phfwdAddLength(struct PhoneForward *pf, char const *num1, size_t len1,
+                    char const *num2, size_t len2) {
+    return phoneForwardAddLength(pf, num1, len1, num2, len2);
+}
+
 void phfwdRemove(struct PhoneForward *pf, char const *num) {
     return phoneForwardRemove(pf, num);
 }
@@ -35,10 +41,36 @@ struct PhoneNumbers const *phfwdGet(struct PhoneForward *pf, char const *num) {
     return phoneForwardGet(pf, num);
 }
 
+struct PhoneNumbers const *phfwdGetLength(struct PhoneForward *pf,
+                                          char const *num, size_t len) {
+    return phoneForwardGetLength(pf, num, len);
+}
+
 struct PhoneNumbers const *phfwdReverse(struct PhoneForward *pf, char const *num) {
     return phoneForwardReverse(pf, num);
 }
 
+struct PhoneNumbers const *phfwdGetBatch(struct PhoneForward *pf,
+                                         char const *const *nums, size_t n) {
+    return phoneForwardGetBatch(pf, nums, n);
+}
+
+struct PhoneNumbers const *phfwdGetInterleaved(struct PhoneForward *pf,
+                                               char const *const *nums,
+                                               size_t n) {
+    return phoneForwardGetInterleaved(pf, nums, n);
+}
+
+size_t phfwdGetInto(struct PhoneForward *pf, char const *num, char *buf,
+                    size_t cap) {
+    return phoneForwardGetInto(pf, num, buf, cap);
+}
+
+size_t phfwdReverseInto(struct PhoneForward *pf, char const *num, char *buf,
+                        size_t cap, size_t *count) {
+    return phoneForwardReverseInto(pf, num, buf, cap, count);
+}
+
 void phnumDelete(struct PhoneNumbers const *pnum) {
     return phoneNumbersDelete(pnum);
 }
@@ -50,3 +82,16 @@ char const *phnumGet(struct PhoneNumbers const *pnum, size_t idx) {
 size_t phfwdNonTrivialCount(struct PhoneForward *pf, char const *set, size_t len) {
     return phoneForwardNonTrivialCount(pf, set, len);
 }
+
+struct PhoneForwardPool *phfwdPoolNew(unsigned threads) {
+    return phoneForwardPoolCreate(threads);
+}
+
+void phfwdPoolDelete(struct PhoneForwardPool *pool) {
+    phoneForwardPoolDestroy(pool);
+}
+
+size_t phfwdNonTrivialCountParallel(struct PhoneForward *pf, char const *set,
+                                    size_t len, struct PhoneForwardPool *pool) {
+    return phoneForwardNonTrivialCountParallel(pf, set, len, pool);
+}
@@ -23,6 +23,11 @@ struct PhoneForward;
  */
 struct PhoneNumbers;
 
+/**
+ * Pula wątków używanych do obliczania liczby nietrywialnych numerów.
+ */
+struct PhoneForwardPool;
+
 /** @brief Tworzy nową strukturę.
  * Tworzy nową strukturę niezawierającą żadnych przekierowań.
  * @return Wskaźnik na utworzoną strukturę lub @c NULL, gdy nie udało się
@@ -57,6 +62,23 @@ void phfwdDelete(struct PhoneForward *pf);
  */
 bool phfwdAdd(struct PhoneForward *pf, char const *num1, char const *num2);
 
+/** @brief Dodaje przekierowanie dla numerów danej długości.
+ * Działa jak @ref phfwdAdd, ale numerami są pierwsze @p len1 znaków napisu
+ * @p num1 i pierwsze @p len2 znaków napisu @p num2, które nie muszą być
+ * zakończone znakiem @c '\0'.
+ * @param[in] pf – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[out] pf – wskaźnik na tą samą strukturę po wykonaniu na niej opisanej
+ *                  w @ref phfwdAdd operacji;
+ * @param num1 – wskaźnik na prefiks numerów przekierowywanych;
+ * @param len1 – długość @p num1;
+ * @param num2 – wskaźnik na prefiks numerów, na które jest wykonywane
+ *               przekierowanie;
+ * @param len2 – długość @p num2.
+ * @return Wynik jak w @ref phfwdAdd.
+ */
+bool phfwdAddLength(struct PhoneForward *pf, char const *num1, size_t len1,
+                    char const *num2, size_t len2);
+
 /** @brief Usuwa przekierowania.
  * Usuwa wszystkie przekierowania, w których parametr @p num jest prefiksem
  * parametru @p num1 użytego przy dodawaniu. Jeśli nie ma takich przekierowań
@@ -84,6 +106,17 @@ void phfwdRemove(struct PhoneForward *pf, char const *num);
  */
 struct PhoneNumbers const *phfwdGet(struct PhoneForward *pf, char const *num);
 
+/** @brief Wyznacza przekierowanie numeru danej długości.
+ * Działa jak @ref phfwdGet, ale numerem jest pierwsze @p len znaków napisu
+ * @p num, który nie musi być zakończony znakiem @c '\0'.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param num – wskaźnik na numer;
+ * @param len – długość numeru.
+ * @return Wynik jak w @ref phfwdGet.
+ */
+struct PhoneNumbers const *phfwdGetLength(struct PhoneForward *pf,
+                                          char const *num, size_t len);
+
 /** @brief Wyznacza przekierowania na dany numer.
  * Wyznacza wszystkie przekierowania na podany numer. Wynikowy ciąg zawiera też
  * dany numer. Wynikowe numery są posortowane leksykograficznie i nie mogą się
@@ -99,6 +132,79 @@ struct PhoneNumbers const *phfwdGet(struct PhoneForward *pf, char const *num);
  */
 struct PhoneNumbers const *phfwdReverse(struct PhoneForward *pf, char const *num);
 
+/** @brief Wyznacza przekierowania wielu numerów.
+ * Wyznacza przekierowanie każdego z @p n podanych numerów tak jak
+ * @ref phfwdGet. Numery o wspólnych prefiksach są przetwarzane razem, więc
+ * koszt zależy od liczby różnych fragmentów ścieżek w drzewie, a nie od
+ * liczby numerów. Wyniki są zapisane w jednej strukturze w kolejności
+ * numerów - @c i-ty napis to przekierowanie @c i-tego numeru, albo pusty
+ * napis, jeśli @c i-ty napis nie reprezentuje numeru. Alokuje strukturę
+ * @p PhoneNumbers, która musi być zwolniona za pomocą funkcji @ref phnumDelete.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[in] nums – wskaźnik na tablicę @p n napisów;
+ * @param n – liczba napisów.
+ * @return Wskaźnik na strukturę przechowującą ciąg numerów lub @c NULL, gdy
+ *         nie udało się zaalokować pamięci. Jeśli @p pf lub @p nums ma
+ *         wartość @c NULL, wynikiem jest pusty ciąg.
+ */
+struct PhoneNumbers const *phfwdGetBatch(struct PhoneForward *pf,
+                                         char const *const *nums, size_t n);
+
+/** @brief Wyznacza przekierowania wielu numerów naprzemiennie.
+ * Daje takie same wyniki jak @ref phfwdGetBatch, ale zamiast grupować numery
+ * o wspólnych prefiksach przechodzi drzewo dla wielu numerów jednocześnie,
+ * pobierając z wyprzedzeniem kolejne wierzchołki każdego z nich. Nadaje się
+ * dla niezwiązanych ze sobą numerów w bazach większych niż pamięć podręczna
+ * procesora. Alokuje strukturę @p PhoneNumbers, która musi być zwolniona za
+ * pomocą funkcji @ref phnumDelete.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[in] nums – wskaźnik na tablicę @p n napisów;
+ * @param n – liczba napisów.
+ * @return Wskaźnik na strukturę przechowującą ciąg numerów lub @c NULL, gdy
+ *         nie udało się zaalokować pamięci. Jeśli @p pf lub @p nums ma
+ *         wartość @c NULL, wynikiem jest pusty ciąg.
+ */
+struct PhoneNumbers const *phfwdGetInterleaved(struct PhoneForward *pf,
+                                               char const *const *nums,
+                                               size_t n);
+
+/** @brief Wyznacza przekierowanie numeru do bufora.
+ * Wyznacza przekierowanie podanego numeru tak jak @ref phfwdGet, ale nie
+ * alokuje pamięci - wynik jest zapisywany jako napis zakończony znakiem
+ * @c '\0' do bufora @p buf podanego przez wywołującego. Jeśli wynik się nie
+ * mieści, bufor nie jest zmieniany, a zwracany jest jego wymagany rozmiar.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[in] num – wskaźnik na napis reprezentujący numer;
+ * @param[out] buf – wskaźnik na bufor na wynik;
+ * @param cap – rozmiar bufora @p buf.
+ * @return Rozmiar wyniku razem ze znakiem @c '\0', lub wartość @c 0, jeśli
+ *         wynikiem jest pusty ciąg. Wynik został zapisany wtedy i tylko wtedy,
+ *         gdy zwrócona wartość jest dodatnia i nie większa niż @p cap.
+ */
+size_t phfwdGetInto(struct PhoneForward *pf, char const *num, char *buf,
+                    size_t cap);
+
+/** @brief Wyznacza przekierowania na dany numer do bufora.
+ * Wyznacza przekierowania na podany numer tak jak @ref phfwdReverse, ale nie
+ * alokuje pamięci - wynikowe numery są zapisywane kolejno, jako napisy
+ * zakończone znakiem @c '\0', na początek obszaru roboczego @p buf podanego
+ * przez wywołującego. Obszar musi pomieścić również numery przed usunięciem
+ * powtórzeń, więc jego wymagany rozmiar może być większy niż rozmiar wyniku.
+ * Jeśli obszar jest za mały, nie jest zmieniany, a zwracany jest jego
+ * wymagany rozmiar.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[in] num – wskaźnik na napis reprezentujący numer;
+ * @param[out] buf – wskaźnik na obszar roboczy;
+ * @param cap – rozmiar obszaru @p buf;
+ * @param[out] count – wskaźnik na zmienną, do której zostanie zapisana liczba
+ *                     zapisanych numerów.
+ * @return Wymagany rozmiar obszaru roboczego, lub wartość @c 0, jeśli
+ *         wynikiem jest pusty ciąg. Wynik został zapisany wtedy i tylko wtedy,
+ *         gdy zwrócona wartość jest dodatnia i nie większa niż @p cap.
+ */
+size_t phfwdReverseInto(struct PhoneForward *pf, char const *num, char *buf,
+                        size_t cap, size_t *count);
+
 /** @brief Usuwa strukturę.
  * Usuwa strukturę wskazywaną przez @p pnum. Nic nie robi, jeśli wskaźnik ten ma
  * wartość @c NULL.
@@ -123,6 +229,9 @@ char const *phnumGet(struct PhoneNumbers const *pnum, size_t idx);
  * tylko cyfry, które znajdują się w napisie set. Obliczenia wykonuje modulo
  * @c 2 do potęgi liczba bitów reprezentacji typu @c size_t. Napis @p set może
  * zawierać dowolne znaki.
+ * Funkcja zapisuje w bazie wyniki i dane pomocnicze do kolejnych wywołań, więc
+ * nie może być wywoływana dla tej samej bazy jednocześnie z żadną inną
+ * funkcją, także czytającą, wywoływaną w innym wątku.
  * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
  * @param[out] pf – wskaźnik na tą samą strukturę;
  * @param set – wskaźnik na napis;
@@ -135,4 +244,39 @@ char const *phnumGet(struct PhoneNumbers const *pnum, size_t idx);
  */
 size_t phfwdNonTrivialCount(struct PhoneForward *pf, char const *set, size_t len);
 
+/** @brief Tworzy pulę wątków.
+ * Tworzy pulę wątków do użycia w @ref phfwdNonTrivialCountParallel. Wątki
+ * czekają na zadania do usunięcia puli, więc nie są tworzone przy każdym
+ * wywołaniu.
+ * @param threads – łączna liczba wątków obliczających, razem z wątkiem
+ *                  wywołującym.
+ * @return Wskaźnik na utworzoną pulę lub @c NULL, gdy @p threads jest mniejsze
+ *         od @c 2 lub nie udało się zaalokować pamięci albo uruchomić wątków.
+ */
+struct PhoneForwardPool *phfwdPoolNew(unsigned threads);
+
+/** @brief Usuwa pulę wątków.
+ * Zatrzymuje wątki puli i zwalnia jej pamięć. Nic nie robi, jeśli wskaźnik
+ * @p pool ma wartość @c NULL.
+ * @param[in] pool – wskaźnik na usuwaną pulę.
+ */
+void phfwdPoolDelete(struct PhoneForwardPool *pool);
+
+/** @brief Funkcja oblicza liczbę nietrywialnych numerów w wątkach puli.
+ * Działa jak @ref phfwdNonTrivialCount. Pierwsze wywołanie po zmianie
+ * przekierowań przechodzi drzewo bazy, dzieląc je na poddrzewa przechodzone
+ * przez wątki puli @p pool. Jeśli @p pool ma wartość @c NULL lub pula jest w
+ * tym czasie używana przez inny wątek, obliczenia wykonuje tylko wątek
+ * wywołujący. Ograniczenia dotyczące wątków są takie same, jak w
+ * @ref phfwdNonTrivialCount.
+ * @param[in] pf  – wskaźnik na strukturę przechowującą przekierowania numerów;
+ * @param[out] pf – wskaźnik na tą samą strukturę;
+ * @param set – wskaźnik na napis;
+ * @param len – długość zliczanych numerów telefonów;
+ * @param pool – wskaźnik na pulę wątków lub @c NULL.
+ * @return Taka sama wartość, jak @ref phfwdNonTrivialCount.
+ */
+size_t phfwdNonTrivialCountParallel(struct PhoneForward *pf, char const *set,
+                                    size_t len, struct PhoneForwardPool *pool);
+
 #endif /* __PHONE_FORWARD_H__ */
\ No newline at end of file
@@ -8,37 +8,74 @@
 
 #include <stdbool.h>
 #include <stdlib.h>
+#include <string.h>
 #include "phone_forward_add.h"
 #include "phone_forward_struct.h"
 #include "phone_forward_list.h"
+#include "phone_forward_non_trivial_count.h"
 
 bool phoneForwardAdd(struct PhoneForward *phoneForward, char const *number1,
                      char const *number2) {
-    struct PhoneForward *number1Node, *number2Node;
+    return phoneForwardAddLength(phoneForward,
+                                 number1, number1 == NULL ? 0 : strlen(number1),
+                                 number2, number2 == NULL ? 0 : strlen(number2));
+}
+
+bool phoneForwardAddLength(struct PhoneForward *phoneForward,
+                           char const *number1, size_t length1,
+                           char const *number2, size_t length2) {
+    uint32_t number1Node, number2Node;
+    struct PhoneForwardNode *number1NodePtr;
 
     // Sprawdzenie poprawności wejścia
     if (phoneForward == NULL)
         return false;
 
     // Znalezienie wierzchołków odpowiadających danym słowom
-    number1Node = phoneForwardFromString(phoneForward, number1);
-    number2Node = phoneForwardFromString(phoneForward, number2);
+    number1Node = phoneForwardFromStringLength(phoneForward, number1, length1);
+    number2Node = phoneForwardFromStringLength(phoneForward, number2, length2);
 
-    // Sprawdzenie poprawności numerów
-    if (number1Node == NULL || number2Node == NULL || number1Node == number2Node
-        || number1Node == phoneForward || number2Node == phoneForward)
+    /*
+     * Sprawdzenie poprawności numerów i zarezerwowanie miejsca na grupę, do
+     * której może trafić cel przekierowania.
+     */
+    if (number1Node == PHONE_FORWARD_NULL || number2Node == PHONE_FORWARD_NULL
+        || number1Node == number2Node || number1Node == PHONE_FORWARD_ROOT
+        || number2Node == PHONE_FORWARD_ROOT
+        || !phoneForwardNonTrivialReserve(phoneForward)) {
+        // Usunięcie wierzchołków utworzonych na potrzeby tej operacji
+        phoneForwardMarkPending(phoneForward, number1Node);
+        phoneForwardMarkPending(phoneForward, number2Node);
+        phoneForwardCollectPending(phoneForward);
         return false;
+    }
+    number1NodePtr = phoneForwardNode(phoneForward, number1Node);
 
-    // Usunięcie starego przekierowania jeśli istniało
-    if (number1Node->forwardTo != NULL)
-        phoneForwardListRemove(number1Node->forwardTo->revert, number1Node);
+    /*
+     * Usunięcie starego przekierowania jeśli istniało - jego cel mógł przestać
+     * być potrzebny.
+     */
+    if (number1NodePtr->forwardTo != PHONE_FORWARD_NULL) {
+        phoneForwardListRemove(phoneForward, number1NodePtr->forwardTo,
+                               number1Node);
+        phoneForwardMarkPending(phoneForward, number1NodePtr->forwardTo);
+    } else {
+        /*
+         * Numer staje się najbliższym przekierowywanym prefiksem dla swojego
+         * poddrzewa, poza częściami poniżej innych przekierowań.
+         */
+        phoneForwardSetForwardAncestor(phoneForward, number1Node,
+                                       number1NodePtr->forwardAncestor,
+                                       number1Node);
+    }
 
     // Dodanie informacji o odwrotności przekierowania
-    if (!phoneForwardListAdd(number2Node->revert, number1Node))
-        return false;
+    phoneForwardListAdd(phoneForward, number2Node, number1Node);
 
     // Dodanie informacji o przekierowaniu
-    number1Node->forwardTo = number2Node;
+    number1NodePtr->forwardTo = number2Node;
+    phoneForward->version++;
+    phoneForwardCollectPending(phoneForward);
 
     return true;
-}
\ No newline at end of file
+}
@@ -34,4 +34,19 @@
 bool phoneForwardAdd(struct PhoneForward *phoneForward, char const *number1,
                      char const *number2);
 
+/** @brief Dodaje przekierowanie dla numerów danej długości.
+ * Działa jak @ref phfwdAddLength.
+ * @param phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                       numerów;
+ * @param number1 – wskaźnik na prefiks numerów przekierowywanych;
+ * @param length1 – długość @p number1;
+ * @param number2 – wskaźnik na prefiks numerów, na które jest wykonywane
+ *                  przekierowanie;
+ * @param length2 – długość @p number2.
+ * @return Wynik jak w @ref phoneForwardAdd.
+ */
+bool phoneForwardAddLength(struct PhoneForward *phoneForward,
+                           char const *number1, size_t length1,
+                           char const *number2, size_t length2);
+
 #endif //TEL_PHONE_FORWARD_ADD_H
@@ -7,82 +7,560 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "phone_forward_get.h"
 #include "phone_numbers.h"
 #include "phone_forward_struct.h"
 
-struct PhoneNumbers const *phoneForwardGet(struct PhoneForward *phoneForward,
-                                           char const *number) {
-    struct PhoneForward *numberNode, *numberNodeCopy;
-    char **resultStrings;
-    size_t size;
-    // Flaga mówiąca nam, czy już wykonaliśmy skok będący przekierowaniem
-    bool jumped;
+/**
+ * Liczba zapytań przetwarzanych naprzemiennie przez
+ * @ref phoneForwardGetInterleaved
+ */
+#define GET_GROUP_SIZE 16
+
+/**
+ * @brief Schodzi o jedną krawędź w dół drzewa.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – wskaźnik na wierzchołek, z którego schodzimy;
+ * @param rest – wskaźnik na niedopasowaną jeszcze resztę numeru.
+ * @return Indeks syna wierzchołka @p node, którego cała etykieta jest
+ *         początkiem napisu @p rest, lub @ref PHONE_FORWARD_NULL, jeśli takiego
+ *         syna nie ma.
+ */
+uint32_t phoneForwardGetStep(struct PhoneForward *phoneForward,
+                             struct PhoneForwardNode *node, char const *rest) {
+    uint32_t next;
+    struct PhoneForwardNode *nextNode;
+
+    if (rest[0] < FIRST_LETTER || rest[0] > LAST_LETTER)
+        return PHONE_FORWARD_NULL;
+    next = phoneForwardChild(phoneForward, node,
+                             (unsigned) (rest[0] - FIRST_LETTER));
+    if (next == PHONE_FORWARD_NULL)
+        return PHONE_FORWARD_NULL;
+
+    // Cała etykieta krawędzi musi być początkiem reszty słowa
+    nextNode = phoneForwardNode(phoneForward, next);
+    if (strncmp(rest, nextNode->label, nextNode->labelLength) != 0)
+        return PHONE_FORWARD_NULL;
+    return next;
+}
+
+/**
+ * @brief Wyznacza przekierowanie numeru.
+ * Pomocnicza do @ref phoneForwardGetLength i @ref phoneForwardGetInto.
+ * Wynikiem jest numer reprezentowany przez wierzchołek @p target, z dopisaną
+ * resztą numeru @p number od pozycji @p matched.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param number – wskaźnik na napis, który nie musi być zakończony znakiem
+ *                 @c '\0';
+ * @param length – niezerowa długość napisu;
+ * @param[out] target – wskaźnik na zmienną, do której zostanie zapisany indeks
+ *                      wierzchołka, na który jest przekierowanie (lub
+ *                      korzenia);
+ * @param[out] matched – wskaźnik na zmienną, do której zostanie zapisana
+ *                       długość przekierowywanego prefiksu numeru.
+ * @return Wartość @c true, jeśli napis @p number reprezentuje numer.
+ *         Wartość @c false w przeciwnym przypadku.
+ */
+bool phoneForwardGetTarget(struct PhoneForward *phoneForward,
+                           char const *number, size_t length,
+                           uint32_t *target, size_t *matched) {
+    uint32_t next, forwarding;
+    struct PhoneForwardNode *currentNode, *nextNode;
     size_t i;
 
+    /*
+     * Schodzenie w dół drzewa bez tworzenia nowych wierzchołków, dopóki cała
+     * etykieta kolejnej krawędzi jest początkiem reszty numeru.
+     */
+    currentNode = phoneForwardNode(phoneForward, PHONE_FORWARD_ROOT);
+    i = 0;
+    while (i < length && number[i] >= FIRST_LETTER &&
+           number[i] <= LAST_LETTER) {
+        next = phoneForwardChild(phoneForward, currentNode,
+                                 (unsigned) (number[i] - FIRST_LETTER));
+        if (next == PHONE_FORWARD_NULL)
+            break;
+        nextNode = phoneForwardNode(phoneForward, next);
+        if (nextNode->labelLength > length - i ||
+            memcmp(number + i, nextNode->label, nextNode->labelLength) != 0)
+            break;
+        currentNode = nextNode;
+        i += nextNode->labelLength;
+    }
+
+    // Najgłębszy wierzchołek z przekierowaniem jest zapamiętany w ostatnim
+    forwarding = currentNode->forwardAncestor;
+    if (forwarding == PHONE_FORWARD_NULL)
+        forwarding = PHONE_FORWARD_ROOT;
+
+    // Sprawdzenie poprawności reszty numeru
+    for (; i < length; i++)
+        if (number[i] < FIRST_LETTER || number[i] > LAST_LETTER)
+            return false;
+
+    // Wynik w korzeniu to sam numer
+    currentNode = phoneForwardNode(phoneForward, forwarding);
+    *matched = (size_t) currentNode->depth;
+    *target = forwarding;
+    if (currentNode->forwardTo != PHONE_FORWARD_NULL)
+        *target = currentNode->forwardTo;
+    return true;
+}
+
+struct PhoneNumbers const *phoneForwardGet(struct PhoneForward *phoneForward,
+                                           char const *number) {
     // Sprawdzenie poprawności wejścia
-    if (phoneForward == NULL)
+    if (phoneForward == NULL || number == NULL)
         return phoneNumbersCreateEmpty();
-    i = 0;
-    if (number == NULL)
+
+    return phoneForwardGetLength(phoneForward, number, strlen(number));
+}
+
+struct PhoneNumbers const *phoneForwardGetLength(
+        struct PhoneForward *phoneForward, char const *number,
+        size_t length) {
+    uint32_t target;
+    struct PhoneForwardNode *targetNode;
+    struct PhoneNumbers *result;
+    char const **sequence;
+    char *characters;
+    size_t matched;
+
+    // Sprawdzenie poprawności wejścia
+    if (phoneForward == NULL || number == NULL)
         return phoneNumbersCreateEmpty();
-    while (number[i] != '\0') {
-        if (number[i] < FIRST_LETTER || number[i] > LAST_LETTER)
-            return phoneNumbersCreateEmpty();
-        i++;
-    }
 
-    // Wyznaczenie wierzchołka w drzewie
-    numberNode = phoneForwardFromString(phoneForward, number);
     // Jeśli podany numer jest pustym prefiksem, to nie jest poprawnym numerem
-    if (numberNode == phoneForward)
+    if (length == 0)
         return phoneNumbersCreateEmpty();
-    // Błąd alokacji pamięci w @ref phoneForwardFromString
-    if (numberNode == NULL)
+
+    if (!phoneForwardGetTarget(phoneForward, number, length, &target,
+                               &matched))
+        return phoneNumbersCreateEmpty();
+    targetNode = phoneForwardNode(phoneForward, target);
+
+    // Zapisanie wyniku w jednym bloku pamięci razem ze strukturą
+    result = phoneNumbersAllocate(
+            1, (size_t) targetNode->depth + length - matched + 1, &sequence,
+            &characters);
+    if (result == NULL)
         return NULL;
-    numberNodeCopy = numberNode;
+    phoneForwardWriteString(phoneForward, target, characters);
+    memcpy(characters + targetNode->depth, number + matched, length - matched);
+    characters[(size_t) targetNode->depth + length - matched] = '\0';
+    sequence[0] = characters;
+
+    return result;
+}
+
+size_t phoneForwardGetInto(struct PhoneForward *phoneForward,
+                           char const *number, char *buffer, size_t capacity) {
+    uint32_t target;
+    struct PhoneForwardNode *targetNode;
+    size_t matched, length, required;
+
+    // Sprawdzenie poprawności wejścia
+    if (phoneForward == NULL || number == NULL || number[0] == '\0')
+        return 0;
+    length = strlen(number);
+    if (!phoneForwardGetTarget(phoneForward, number, length, &target,
+                               &matched))
+        return 0;
+    targetNode = phoneForwardNode(phoneForward, target);
+
+    // Zapisanie wyniku tylko wtedy, gdy się mieści
+    required = (size_t) targetNode->depth + length - matched + 1;
+    if (required > capacity || buffer == NULL)
+        return required;
+    phoneForwardWriteString(phoneForward, target, buffer);
+    memcpy(buffer + targetNode->depth, number + matched, length - matched + 1);
+    return required;
+}
 
-    // Znalezienie długości wyjściowego numeru
-    size = 0;
-    while (numberNode->nodeChar != '\0') {
-        if (numberNode->forwardTo != NULL) {
-            size += numberNode->forwardTo->depth;
+/**
+ * @brief Zapytanie w grupie zapytań.
+ * Informacje o jednym numerze z grupy przetwarzanej przez
+ * @ref phoneForwardGetBatch.
+ */
+struct PhoneForwardBatchQuery {
+    /**@{*/
+
+    char const *number;
+    /**<
+     * Numer, którego przekierowanie jest wyznaczane.
+     */
+
+    size_t index;
+    /**<
+     * Pozycja numeru w danych wejściowych.
+     */
+
+    size_t matched;
+    /**<
+     * Długość przekierowywanego prefiksu numeru.
+     */
+
+    size_t length;
+    /**<
+     * Długość numeru, lub @c SIZE_MAX, jeśli napis nie reprezentuje numeru.
+     */
+
+    uint32_t target;
+    /**<
+     * Indeks wierzchołka, na który jest przekierowanie (lub korzenia).
+     */
+
+    uint32_t candidate;
+    /**<
+     * Indeks wierzchołka, którego etykieta będzie sprawdzana w następnym
+     * kroku @ref phoneForwardGetInterleaved, lub @ref PHONE_FORWARD_NULL,
+     * jeśli zejście w dół drzewa się zakończyło.
+     */
+
+    uint32_t current;
+    /**<
+     * Ostatni wierzchołek, którego etykieta została dopasowana (lub korzeń).
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Kończy wyznaczanie przekierowania.
+ * Sprawdza poprawność reszty numeru zapytania od pozycji @p position i
+ * zapisuje w zapytaniu wynik wyznaczony przez najgłębszy wierzchołek z
+ * przekierowaniem na ścieżce numeru, zapamiętany w ostatnim dopasowanym
+ * wierzchołku.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param[in, out] query – wskaźnik na zapytanie;
+ * @param position – długość prefiksu numeru dopasowanego w drzewie;
+ * @param current – wierzchołek reprezentujący dopasowany prefiks.
+ * @return Długość wyniku razem ze znakiem @c '\0'.
+ */
+size_t phoneForwardGetFinish(struct PhoneForward *phoneForward,
+                             struct PhoneForwardBatchQuery *query,
+                             size_t position, uint32_t current) {
+    struct PhoneForwardNode *forwardingNode;
+    char const *number;
+    uint32_t forwarding;
+
+    // Sprawdzenie poprawności reszty numeru i wyznaczenie jego długości
+    number = query->number;
+    for (; number[position] != '\0'; position++)
+        if (number[position] < FIRST_LETTER || number[position] > LAST_LETTER)
             break;
-        } else {
-            size++;
-            numberNode = numberNode->prev;
+    if (number[position] != '\0' || position == 0) {
+        query->length = SIZE_MAX;
+        return 1;
+    }
+    query->length = position;
+
+    // Wynik jak w phoneForwardGetTarget
+    forwarding = phoneForwardNode(phoneForward, current)->forwardAncestor;
+    if (forwarding == PHONE_FORWARD_NULL)
+        forwarding = PHONE_FORWARD_ROOT;
+    forwardingNode = phoneForwardNode(phoneForward, forwarding);
+    query->matched = (size_t) forwardingNode->depth;
+    query->target = forwarding;
+    if (forwardingNode->forwardTo != PHONE_FORWARD_NULL)
+        query->target = forwardingNode->forwardTo;
+    return (size_t) phoneForwardNode(phoneForward, query->target)->depth +
+           position - query->matched + 1;
+}
+
+/**
+ * @brief Tworzy strukturę z wynikami zapytań.
+ * Zapisuje wyniki zapytań w kolejności wejściowej w jednym bloku pamięci.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param queries – tablica zapytań z wyznaczonymi wynikami;
+ * @param n – liczba zapytań;
+ * @param total – łączna długość wyników razem ze znakami @c '\0'.
+ * @return Wskaźnik na strukturę przechowującą wyniki, lub @c NULL, gdy nie
+ *         udało się zaalokować pamięci.
+ */
+struct PhoneNumbers *phoneForwardGetResults(
+        struct PhoneForward *phoneForward,
+        struct PhoneForwardBatchQuery const *queries, size_t n,
+        size_t total) {
+    struct PhoneNumbers *result;
+    struct PhoneForwardNode *targetNode;
+    char const **sequence;
+    char *characters;
+    size_t q, rest;
+
+    result = phoneNumbersAllocate(n, total, &sequence, &characters);
+    if (result == NULL)
+        return NULL;
+    for (q = 0; q < n; q++) {
+        sequence[queries[q].index] = characters;
+        if (queries[q].length == SIZE_MAX) {
+            *characters++ = '\0';
+            continue;
         }
+        targetNode = phoneForwardNode(phoneForward, queries[q].target);
+        rest = queries[q].length - queries[q].matched;
+        phoneForwardWriteString(phoneForward, queries[q].target, characters);
+        characters += targetNode->depth;
+        memcpy(characters, queries[q].number + queries[q].matched, rest + 1);
+        characters += rest + 1;
     }
+    return result;
+}
 
-    // Zaalokowanie struktury będącej wynikową tablicą stringów
-    resultStrings = malloc(sizeof(char *));
-    if (resultStrings == NULL)
+/**
+ * @brief Przygotowuje zapytania.
+ * @param numbers – tablica @p n napisów różnych od @c NULL;
+ * @param n – liczba napisów;
+ * @param[out] maxLength – wskaźnik na zmienną, do której zostanie zapisana
+ *                         długość najdłuższego napisu, lub @c NULL.
+ * @return Tablica zapytań o kolejne napisy, lub @c NULL, gdy nie udało się
+ *         zaalokować pamięci.
+ */
+struct PhoneForwardBatchQuery *phoneForwardGetQueries(
+        char const *const *numbers, size_t n, size_t *maxLength) {
+    struct PhoneForwardBatchQuery *queries;
+    size_t q, length;
+
+    queries = malloc((n > 0 ? n : 1) * sizeof(struct PhoneForwardBatchQuery));
+    if (queries == NULL)
         return NULL;
-    resultStrings[0] = malloc((size + 1) * sizeof(char *));
-    if (resultStrings[0] == NULL) {
-        free(resultStrings);
+    if (maxLength != NULL)
+        *maxLength = 0;
+    for (q = 0; q < n; q++) {
+        queries[q].number = numbers[q];
+        queries[q].index = q;
+        if (maxLength != NULL) {
+            length = strlen(numbers[q]);
+            if (length > *maxLength)
+                *maxLength = length;
+        }
+    }
+    return queries;
+}
+
+/**
+ * @brief Porównuje zapytania.
+ * Porządek leksykograficzny numerów zapytań, do użycia w @c qsort.
+ * @param a – wskaźnik na pierwsze zapytanie;
+ * @param b – wskaźnik na drugie zapytanie.
+ * @return Wynik funkcji @c strcmp na numerach zapytań.
+ */
+int phoneForwardBatchQueryCompare(void const *a, void const *b) {
+    return strcmp(((struct PhoneForwardBatchQuery const *) a)->number,
+                  ((struct PhoneForwardBatchQuery const *) b)->number);
+}
+
+/**
+ * @brief Wyznacza przekierowania posortowanych numerów.
+ * Pomocnicza do @ref phoneForwardGetBatch. Przetwarza zapytania w kolejności
+ * leksykograficznej, pamiętając ścieżkę z korzenia dla poprzedniego numeru,
+ * więc wspólny prefiks kolejnych numerów nie jest przechodzony ponownie.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param[in, out] queries – posortowana tablica zapytań, w której są
+ *                           uzupełniane wyniki;
+ * @param n – liczba zapytań;
+ * @param path – tablica na indeksy wierzchołków ścieżki, rozmiaru większego
+ *               niż długość najdłuższego numeru.
+ * @return Łączna długość wyników razem ze znakami @c '\0'.
+ */
+size_t phoneForwardGetSorted(struct PhoneForward *phoneForward,
+                             struct PhoneForwardBatchQuery *queries, size_t n,
+                             uint32_t *path) {
+    struct PhoneForwardNode *currentNode;
+    char const *number, *previous;
+    uint32_t next;
+    size_t q, i, top, total;
+
+    // Na dnie stosu zawsze jest korzeń
+    path[0] = PHONE_FORWARD_ROOT;
+    top = 0;
+    previous = "";
+    total = 0;
+
+    for (q = 0; q < n; q++) {
+        number = queries[q].number;
+
+        /*
+         * Zdjęcie ze ścieżki wierzchołków, które nie są prefiksami aktualnego
+         * numeru - dla posortowanych numerów wystarczy wspólny prefiks z
+         * poprzednim numerem.
+         */
+        for (i = 0; number[i] != '\0' && number[i] == previous[i]; i++);
+        while (phoneForwardNode(phoneForward, path[top])->depth > (int) i)
+            top--;
+        currentNode = phoneForwardNode(phoneForward, path[top]);
+        i = (size_t) currentNode->depth;
+
+        // Zejście w dół drzewa od ostatniego wspólnego wierzchołka
+        while ((next = phoneForwardGetStep(phoneForward, currentNode,
+                                           number + i)) != PHONE_FORWARD_NULL) {
+            currentNode = phoneForwardNode(phoneForward, next);
+            path[++top] = next;
+            i += currentNode->labelLength;
+        }
+        previous = number;
+
+        total += phoneForwardGetFinish(phoneForward, queries + q, i,
+                                       path[top]);
+    }
+    return total;
+}
+
+struct PhoneNumbers const *phoneForwardGetBatch(
+        struct PhoneForward *phoneForward, char const *const *numbers,
+        size_t n) {
+    struct PhoneForwardBatchQuery *queries;
+    struct PhoneNumbers *result;
+    uint32_t *path;
+    size_t q, maxLength, total;
+
+    // Sprawdzenie poprawności wejścia
+    if (phoneForward == NULL || numbers == NULL)
+        return phoneNumbersCreateEmpty();
+    for (q = 0; q < n; q++)
+        if (numbers[q] == NULL)
+            return phoneNumbersCreateEmpty();
+
+    // Przygotowanie zapytań i ścieżki długości najdłuższego numeru
+    queries = phoneForwardGetQueries(numbers, n, &maxLength);
+    if (queries == NULL)
         return NULL;
+    path = malloc((maxLength + 1) * sizeof(uint32_t));
+    if (path == NULL) {
+        free(queries);
+        return NULL;
+    }
+
+    // Wyznaczenie przekierowań w kolejności leksykograficznej
+    if (n > 0)
+        qsort(queries, n, sizeof(struct PhoneForwardBatchQuery),
+              phoneForwardBatchQueryCompare);
+    total = phoneForwardGetSorted(phoneForward, queries, n, path);
+    free(path);
+
+    // Zapisanie wyników w kolejności wejściowej w jednym bloku pamięci
+    result = phoneForwardGetResults(phoneForward, queries, n, total);
+    free(queries);
+    return result;
+}
+
+/**
+ * @brief Wyznacza przekierowania grupy numerów naprzemiennie.
+ * Pomocnicza do @ref phoneForwardGetInterleaved. Schodzi w dół drzewa dla
+ * wszystkich zapytań grupy jednocześnie, po jednej krawędzi dla każdego
+ * zapytania w kolejnych rundach. Wierzchołek, do którego zapytanie zejdzie w
+ * następnej rundzie, jest pobierany do pamięci podręcznej z wyprzedzeniem,
+ * więc oczekiwanie na pamięć dla różnych zapytań się nakłada.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param[in, out] queries – tablica zapytań, w której są uzupełniane wyniki;
+ * @param n – liczba zapytań w grupie.
+ * @return Łączna długość wyników razem ze znakami @c '\0'.
+ */
+size_t phoneForwardGetGroup(struct PhoneForward *phoneForward,
+                            struct PhoneForwardBatchQuery *queries,
+                            size_t n) {
+    struct PhoneForwardBatchQuery *query;
+    struct PhoneForwardNode *node;
+    size_t q, active, total;
+    uint32_t candidate;
+    char c;
+
+    // Pierwsza krawędź każdego zapytania wychodzi z korzenia
+    node = phoneForwardNode(phoneForward, PHONE_FORWARD_ROOT);
+    total = 0;
+    active = 0;
+    for (q = 0; q < n; q++) {
+        query = queries + q;
+        query->current = PHONE_FORWARD_ROOT;
+        query->matched = 0;
+        c = query->number[0];
+        query->candidate = c >= FIRST_LETTER && c <= LAST_LETTER
+                           ? phoneForwardChild(phoneForward, node,
+                                               (unsigned) (c - FIRST_LETTER))
+                           : PHONE_FORWARD_NULL;
+        if (query->candidate == PHONE_FORWARD_NULL) {
+            total += phoneForwardGetFinish(phoneForward, query, 0,
+                                           PHONE_FORWARD_ROOT);
+            continue;
+        }
+        PHONE_FORWARD_PREFETCH(phoneForwardNode(phoneForward,
+                                                query->candidate));
+        active++;
     }
 
-    // Ustawienie ostatniego znaku na koniec stringa i flagi skoku
-    resultStrings[0][size] = '\0';
-    jumped = false;
-
-    // Ponowne ustawienie wierzchołka odpowiadającemu danemu słowu
-    numberNode = numberNodeCopy;
-
-    // Zapisanie słowa do wynikowej tablicy
-    while (numberNode->nodeChar != '\0') {
-        if (!jumped && numberNode->forwardTo != NULL) {
-            jumped = true;
-            numberNode = numberNode->forwardTo;
-        } else {
-            resultStrings[0][--size] = numberNode->nodeChar;
-            numberNode = numberNode->prev;
+    // Kolejne rundy - każde aktywne zapytanie przechodzi jedną krawędź
+    while (active > 0) {
+        for (q = 0; q < n; q++) {
+            query = queries + q;
+            if (query->candidate == PHONE_FORWARD_NULL)
+                continue;
+
+            /*
+             * Sprawdzenie etykiety pobranego wcześniej wierzchołka - pole
+             * matched przechowuje do końca zejścia długość dopasowanego
+             * prefiksu.
+             */
+            node = phoneForwardNode(phoneForward, query->candidate);
+            candidate = PHONE_FORWARD_NULL;
+            if (strncmp(query->number + query->matched, node->label,
+                        node->labelLength) == 0) {
+                query->matched += node->labelLength;
+                query->current = query->candidate;
+
+                // Wybranie syna na następną rundę i jego pobranie
+                c = query->number[query->matched];
+                if (c >= FIRST_LETTER && c <= LAST_LETTER)
+                    candidate = phoneForwardChild(
+                            phoneForward, node, (unsigned) (c - FIRST_LETTER));
+            }
+
+            query->candidate = candidate;
+            if (candidate != PHONE_FORWARD_NULL) {
+                PHONE_FORWARD_PREFETCH(phoneForwardNode(phoneForward,
+                                                        candidate));
+                continue;
+            }
+
+            // Zakończenie zejścia dla tego zapytania
+            total += phoneForwardGetFinish(phoneForward, query, query->matched,
+                                           query->current);
+            active--;
         }
     }
+    return total;
+}
+
+struct PhoneNumbers const *phoneForwardGetInterleaved(
+        struct PhoneForward *phoneForward, char const *const *numbers,
+        size_t n) {
+    struct PhoneForwardBatchQuery *queries;
+    struct PhoneNumbers *result;
+    size_t q, total;
+
+    // Sprawdzenie poprawności wejścia
+    if (phoneForward == NULL || numbers == NULL)
+        return phoneNumbersCreateEmpty();
+    for (q = 0; q < n; q++)
+        if (numbers[q] == NULL)
+            return phoneNumbersCreateEmpty();
+
+    queries = phoneForwardGetQueries(numbers, n, NULL);
+    if (queries == NULL)
+        return NULL;
+
+    // Wyznaczenie przekierowań kolejnych grup zapytań
+    total = 0;
+    for (q = 0; q < n; q += GET_GROUP_SIZE)
+        total += phoneForwardGetGroup(phoneForward, queries + q,
+                                      n - q < GET_GROUP_SIZE
+                                      ? n - q : GET_GROUP_SIZE);
 
-    // Utworzenie struktury PhoneNumbers i jej zwrócenie
-    return phoneNumbersCreate((const char *const *) resultStrings, 1);
+    // Zapisanie wyników w kolejności wejściowej w jednym bloku pamięci
+    result = phoneForwardGetResults(phoneForward, queries, n, total);
+    free(queries);
+    return result;
 }
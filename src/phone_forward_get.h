@@ -31,4 +31,77 @@
 struct PhoneNumbers const *phoneForwardGet(struct PhoneForward *phoneForward,
                                            char const *number);
 
+/** @brief Wyznacza przekierowanie numeru danej długości.
+ * Działa jak @ref phfwdGetLength.
+ * @param phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                       numerów;
+ * @param number – wskaźnik na numer, który nie musi być zakończony znakiem
+ *                 @c '\0';
+ * @param length – długość numeru.
+ * @return Wynik jak w @ref phoneForwardGet.
+ */
+struct PhoneNumbers const *phoneForwardGetLength(
+        struct PhoneForward *phoneForward, char const *number,
+        size_t length);
+
+/** @brief Wyznacza przekierowanie numeru do bufora.
+ * Działa jak @ref phfwdGetInto.
+ * Wyznacza przekierowanie podanego numeru tak jak @ref phoneForwardGet, ale
+ * zapisuje wynik jako napis zakończony znakiem @c '\0' do bufora @p buffer
+ * podanego przez wywołującego, bez alokowania pamięci. Jeśli wynik się nie
+ * mieści, bufor nie jest zmieniany.
+ * @param[in] phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                           numerów;
+ * @param[in] number – wskaźnik na napis reprezentujący numer;
+ * @param[out] buffer – wskaźnik na bufor na wynik;
+ * @param capacity – rozmiar bufora @p buffer.
+ * @return Rozmiar wyniku razem ze znakiem @c '\0', lub wartość @c 0, jeśli
+ *         wynikiem jest pusty ciąg (np. podany napis nie reprezentuje
+ *         numeru). Wynik został zapisany wtedy i tylko wtedy, gdy zwrócona
+ *         wartość jest dodatnia i nie większa niż @p capacity.
+ */
+size_t phoneForwardGetInto(struct PhoneForward *phoneForward,
+                           char const *number, char *buffer, size_t capacity);
+
+/** @brief Wyznacza przekierowania wielu numerów.
+ * Działa jak @ref phfwdGetBatch.
+ * Wyznacza przekierowania @p n numerów tak jak @ref phoneForwardGet. Numery
+ * są przetwarzane w kolejności leksykograficznej, więc wspólne prefiksy
+ * kolejnych numerów są przechodzone w drzewie tylko raz. Alokuje strukturę
+ * @ref PhoneNumbers, która musi być zwolniona za pomocą funkcji
+ * @ref phnumDelete.
+ * @param[in] phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                           numerów;
+ * @param[in] numbers – wskaźnik na tablicę @p n napisów;
+ * @param n – liczba napisów.
+ * @return Wskaźnik na strukturę przechowującą ciąg @p n wyników w kolejności
+ *         numerów, w której napis niereprezentujący numeru ma pusty wynik,
+ *         ciąg pusty, gdy @p phoneForward lub @p numbers ma wartość @c NULL,
+ *         lub @c NULL, gdy nie udało się zaalokować pamięci.
+ */
+struct PhoneNumbers const *phoneForwardGetBatch(
+        struct PhoneForward *phoneForward, char const *const *numbers,
+        size_t n);
+
+/** @brief Wyznacza przekierowania wielu numerów naprzemiennie.
+ * Działa jak @ref phfwdGetInterleaved.
+ * Daje takie same wyniki jak @ref phoneForwardGetBatch, ale nie sortuje
+ * numerów. Zamiast tego przechodzi drzewo dla grup numerów jednocześnie, po
+ * jednej krawędzi dla każdego numeru w rundzie, pobierając z wyprzedzeniem
+ * kolejne wierzchołki, co ukrywa opóźnienia pamięci dla dużych baz. Alokuje
+ * strukturę @ref PhoneNumbers, która musi być zwolniona za pomocą funkcji
+ * @ref phnumDelete.
+ * @param[in] phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                           numerów;
+ * @param[in] numbers – wskaźnik na tablicę @p n napisów;
+ * @param n – liczba napisów.
+ * @return Wskaźnik na strukturę przechowującą ciąg @p n wyników w kolejności
+ *         numerów, w której napis niereprezentujący numeru ma pusty wynik,
+ *         ciąg pusty, gdy @p phoneForward lub @p numbers ma wartość @c NULL,
+ *         lub @c NULL, gdy nie udało się zaalokować pamięci.
+ */
+struct PhoneNumbers const *phoneForwardGetInterleaved(
+        struct PhoneForward *phoneForward, char const *const *numbers,
+        size_t n);
+
 #endif //TEL_PHONE_FORWARD_GET_H
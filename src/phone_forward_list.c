@@ -1,7 +1,7 @@
 /** @file
- * Implementacja operacji na liście wskaźników na struktury @c PhoneForward
- * stworzonych w pliku @ref phone_forward_struct.h z interfejscem w pliku
- * @ref phone_forward_list.h
+ * Implementacja operacji na liście odwrotności przekierowań wierzchołków
+ * struktury @c PhoneForward stworzonej w pliku @ref phone_forward_struct.h z
+ * interfejscem w pliku @ref phone_forward_list.h
  *
  * @author Witalis Domitrz <witekdomitrz@gmail.com>
  * @date 13.05.2018
@@ -9,93 +9,79 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "phone_forward_list.h"
 #include "phone_forward_struct.h"
+#include "phone_forward_non_trivial_count.h"
 
 /**
- * @brief Tworzy element listy
- * Tworzy element listy będący poprzednikiem @p next i z wartością @p val
- * @param[in, out] next – wskaźnik na następnik nowotworzonego elementu;
- * @param[in, out] val – wskaźnik na wartość nowotworzonego elementu.
- * @return Zwraca wskaźnik na nowoutworzony element, lub @c NULL gdy nie
- *         udało się zaalokować pamięci.
+ * @brief Uaktualnia liczniki przekierowań w poddrzewach.
+ * Zmienia o @p delta liczniki przekierowań na wierzchołki poddrzew na
+ * ścieżce od korzenia do @p target i liczniki przekierowań z wierzchołków
+ * poddrzew na ścieżce od korzenia do @p source.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param target – indeks wierzchołka, na który jest przekierowanie;
+ * @param source – indeks wierzchołka, z którego jest przekierowanie;
+ * @param delta – zmiana liczników, @c 1 lub @c -1.
  */
-struct PhoneForwardList *phoneForwardListElemCreate(
-        struct PhoneForwardList *next, struct PhoneForward *val) {
-    struct PhoneForwardList *newPhoneForwardList;
-
-    // Alokacja nowej struktury
-    newPhoneForwardList = malloc(sizeof(struct PhoneForwardList));
-    if (newPhoneForwardList == NULL)
-        return NULL;
-
-    // Ustawienie wartości
-    newPhoneForwardList->val = val;
-    newPhoneForwardList->next = next;
-
-    // Zwrócenie nowej struktury
-    return newPhoneForwardList;
+static void phoneForwardListCount(struct PhoneForward *phoneForward,
+                                  uint32_t target, uint32_t source,
+                                  int delta) {
+    struct PhoneForwardNode *nodePtr;
+
+    for (; target != PHONE_FORWARD_NULL; target = nodePtr->prev) {
+        nodePtr = phoneForwardNode(phoneForward, target);
+        nodePtr->revertCount += (uint32_t) delta;
+    }
+    for (; source != PHONE_FORWARD_NULL; source = nodePtr->prev) {
+        nodePtr = phoneForwardNode(phoneForward, source);
+        nodePtr->forwardCount += (uint32_t) delta;
+    }
 }
 
-struct PhoneForwardList *phoneForwardListCreate(void) {
-    // Lista pusta to wskaźnik na pierwszy element, który jest NULL-em
-    return phoneForwardListElemCreate(NULL, NULL);
+void phoneForwardListAdd(struct PhoneForward *phoneForward, uint32_t target,
+                         uint32_t source) {
+    struct PhoneForwardNode *targetNode, *sourceNode;
+    bool wasEmpty;
+
+    targetNode = phoneForwardNode(phoneForward, target);
+    sourceNode = phoneForwardNode(phoneForward, source);
+    wasEmpty = phoneForwardListIsEmpty(targetNode->revert);
+
+    // Podpięcie źródła przed dotychczasowy początek listy
+    sourceNode->revertPrev = PHONE_FORWARD_NULL;
+    sourceNode->revertNext = targetNode->revert;
+    if (targetNode->revert != PHONE_FORWARD_NULL)
+        phoneForwardNode(phoneForward, targetNode->revert)->revertPrev = source;
+    targetNode->revert = source;
+
+    phoneForwardListCount(phoneForward, target, source, 1);
+    if (wasEmpty)
+        phoneForwardNonTrivialUpdate(phoneForward, target, true);
 }
 
-void phoneForwardListDestroy(struct PhoneForwardList *phoneForwardList) {
-    // Sprawdzenie, czy nie jesteśmy już na końcu
-    if (phoneForwardList == NULL)
-        return;
-
-    // Zwolnienie kolejnego elementu
-    phoneForwardListDestroy(phoneForwardList->next);
+void phoneForwardListRemove(struct PhoneForward *phoneForward, uint32_t target,
+                            uint32_t source) {
+    struct PhoneForwardNode *sourceNode;
 
-    // Zwolnienie aktualnego elemntu
-    free(phoneForwardList);
-}
+    sourceNode = phoneForwardNode(phoneForward, source);
 
-bool phoneForwardListAdd(struct PhoneForwardList *phoneForwardList,
-                         struct PhoneForward *phoneForward) {
-    struct PhoneForwardList *currentElem;
+    // Przepięcie poprzednika, lub początku listy, jeśli go nie ma
+    if (sourceNode->revertPrev != PHONE_FORWARD_NULL)
+        phoneForwardNode(phoneForward, sourceNode->revertPrev)->revertNext =
+                sourceNode->revertNext;
+    else
+        phoneForwardNode(phoneForward, target)->revert = sourceNode->revertNext;
 
-    // Sprawdzenie poprawności wejścia
-    if (phoneForward == NULL || phoneForwardList == NULL)
-        return false;
+    // Przepięcie następnika
+    if (sourceNode->revertNext != PHONE_FORWARD_NULL)
+        phoneForwardNode(phoneForward, sourceNode->revertNext)->revertPrev =
+                sourceNode->revertPrev;
 
-    // Utworzenie nowego elementu
-    currentElem = phoneForwardListElemCreate(phoneForwardList->next,
-                                             phoneForward);
-    if (currentElem == NULL)
-        return false;
+    sourceNode->revertPrev = PHONE_FORWARD_NULL;
+    sourceNode->revertNext = PHONE_FORWARD_NULL;
 
-    // Dodanie nowego elementu do listy
-    phoneForwardList->next = currentElem;
-    return true;
+    phoneForwardListCount(phoneForward, target, source, -1);
+    if (phoneForwardListIsEmpty(phoneForwardNode(phoneForward, target)->revert))
+        phoneForwardNonTrivialUpdate(phoneForward, target, false);
 }
-
-void phoneForwardListRemove(struct PhoneForwardList *phoneForwardList,
-                            struct PhoneForward const *phoneForward) {
-    struct PhoneForwardList *currentElem, *helper;
-
-    // Sprawdzenie poprawności wejścia
-    if (phoneForward == NULL || phoneForwardList == NULL)
-        return;
-
-    // Przeiterowanie się po liście w celu znalezienie elementu o danej wartości
-    currentElem = phoneForwardList;
-    while (currentElem->next != NULL) {
-        if (currentElem->next->val == phoneForward) {
-            // Usunięcie znalezionego elementu
-            helper = currentElem->next;
-            currentElem->next = helper->next;
-            helper->next = NULL;
-            phoneForwardListDestroy(helper);
-            return;
-        }
-        currentElem = currentElem->next;
-    }
-}
-
-bool phoneForwardListIsEmpty(struct PhoneForwardList *phoneForwardList) {
-    return phoneForwardList->next == NULL;
-}
\ No newline at end of file
@@ -1,6 +1,7 @@
 /** @file
- * Interfejs operacji i deklaracja listy wskaźników na struktury @c PhoneForward
- * zadeklarowanych w pliku @ref phone_forward_struct.h z implementacją w pliku
+ * Interfejs operacji na liście odwrotności przekierowań wierzchołków struktury
+ * @c PhoneForward zadeklarowanej w pliku @ref phone_forward_struct.h z
+ * implementacją w pliku
  * @ref phone_forward_list.c
  *
  * @author Witalis Domitrz <witekdomitrz@gmail.com>
@@ -11,88 +12,51 @@
 #define TEL_PHONE_FORWARD_LIST_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "phone_forward_struct.h"
 
-/**
- * @brief Lista wskaźników na struktury @c PhoneForward
- * Jednokierunkowa lista z elementami będącymi wskaźnikami na struktury
- * @c PhoneForward.
- */
-struct PhoneForwardList {
-    /**@{*/
-
-    struct PhoneForward *val;
-    /**<
-     * Wartość elementu listy.
-     */
-
-    struct PhoneForwardList *next;
-    /**<
-     * Wskaźnik na następny element listy.
-     */
-
-    /**@}*/
-};
-
-/**
- * @brief Tworzy pustą listę
- * Tworzy strukturę będącą reprezentacją pustej listy
- * @return Wskaźnik na nowoutworzoną listę, lub @c NULL gdy nie udało się
- *         zaalokować pamięci
- */
-struct PhoneForwardList *phoneForwardListCreate(void);
-
-/**
- * @brief Niszczy listę
- * Zwalnia listę @p phoneForwardList, ale nie zwalnia jej elementów - te
- * elementy muszą zosać zwolnione oddzielnie.
- * @param[in] phoneForwardList – wskaźnik na listę do zwolnienia;
- * @param[out] phoneForwardList – niezaalokowany wskaźnik.
+/*
+ * Lista odwrotności przekierowań wierzchołka to dwukierunkowa lista
+ * wierzchołków, które się do niego przekierowują. Jest przechowywana w samych
+ * wierzchołkach - cel przekierowania pamięta indeks pierwszego źródła w polu
+ * @c revert, a każde źródło swoich sąsiadów w polach @c revertPrev i
+ * @c revertNext. Wierzchołek przekierowuje się najwyżej na jeden numer, więc
+ * należy najwyżej do jednej listy, a operacje na liście nie alokują pamięci.
  */
-void phoneForwardListDestroy(struct PhoneForwardList *phoneForwardList);
 
 /**
- * @brief Dodaje element do listy
- * Dodaje element o wartości @p phoneForward różnej od @c NULL do listy
- * @p phoneForwardList na jej początek.
- * @param[in] phoneForwardList – wskaźnik na listę do której ma zostać dopisany
- *                               nowy element o wartości @p phoneForward;
- * @param[out] phoneForwardList – wskaźnik na listę do której został dopiany
- *                                nowy element o wartości @p phoneForward jeśli
- *                                dodawanie się powiodło, lub listę wejściową,
- *                                jeśli dodawanie się nie powiodło.
- * @param[in, out] phoneForward – Wskaźnik na wartość elementu do dopisania.
- * @return Wartość @c true, jeśli dodawanie się powiodło.
- *         Wartość @c false, jeśli dodawnia się nie powiodło (np. z powodu
- *         błędu alokacji pamięci, wskaźnik @p phoneForwardList to
- *         @c NULL, albo wskaźnik @p phoneForward to @c NULL).
+ * @brief Dodaje wierzchołek do listy
+ * Dodaje wierzchołek @p source na początek listy odwrotności przekierowań
+ * wierzchołka @p target. Wierzchołek @p source nie może należeć do żadnej
+ * listy. Wcześniej musi zostać wywołana @ref phoneForwardNonTrivialReserve.
+ * @param phoneForward – wskaźnik na bazę zawierającą wierzchołki;
+ * @param target – indeks wierzchołka, do którego listy jest dodawane źródło;
+ * @param source – indeks dodawanego wierzchołka.
  */
-bool phoneForwardListAdd(struct PhoneForwardList *phoneForwardList,
-                         struct PhoneForward *phoneForward);
+void phoneForwardListAdd(struct PhoneForward *phoneForward, uint32_t target,
+                         uint32_t source);
 
 /**
- * @brief Usuwa element z listy
- * Usuwa element o wartości @p phoneForward różnej od @c NULL z listy, jeśli
- * istnieje on w tej liście. W przeciwnym przypadku nic nie robi.
- * @param[in] phoneForwardList – wskaźnik na listę z której ma zostać usunięty
- *                               element @p phoneForward;
- * @param[out] phoneForwardList – wskaźnik na listę z której został usunięty
- *                                element o wartości @p phoneForward jeśli
- *                                usuwanie się powiodło, lub listę wejściową,
- *                                jeśli nie było takiego elementu.
- * @param[in, out] phoneForward – Wskaźnik na wartość elementu do usunięcia.
+ * @brief Usuwa wierzchołek z listy
+ * Usuwa wierzchołek @p source z listy odwrotności przekierowań wierzchołka
+ * @p target w czasie stałym. Wierzchołek @p source musi należeć do tej listy.
+ * @param phoneForward – wskaźnik na bazę zawierającą wierzchołki;
+ * @param target – indeks wierzchołka, z którego listy jest usuwane źródło;
+ * @param source – indeks usuwanego wierzchołka.
  */
-void phoneForwardListRemove(struct PhoneForwardList *phoneForwardList,
-                            struct PhoneForward const *phoneForward);
+void phoneForwardListRemove(struct PhoneForward *phoneForward, uint32_t target,
+                            uint32_t source);
 
 /**
  * @brief Sprawdza, czy lista jest pusta.
  * Sprawdza, czy podana lista jest pusta.
- * @param[in] phoneForwardList – wskaźnik na listę do sprawdzenia pustości;
- * @param[out] phoneForwardList – wskaźnik na tą samą listę.
- * @return Wartość @c true, jeśli @p phoneForwardList jest wskaźnikiem na
- *         pustą listę. W przeciwnym przypadku wartość @c false.
+ * @param phoneForwardList – indeks pierwszego wierzchołka listy do sprawdzenia
+ *                           pustości.
+ * @return Wartość @c true, jeśli @p phoneForwardList jest indeksem pustej
+ *         listy. W przeciwnym przypadku wartość @c false.
  */
-bool phoneForwardListIsEmpty(struct PhoneForwardList *phoneForwardList);
+static inline bool phoneForwardListIsEmpty(uint32_t phoneForwardList) {
+    return phoneForwardList == PHONE_FORWARD_NULL;
+}
 
 #endif //TEL_PHONE_FORWARD_LIST_H
@@ -7,23 +7,110 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
 #include "phone_forward.h"
 #include "dictionary.h"
 #include "input_reader.h"
 #include "operation.h"
+#include "output_writer.h"
+#include "pipeline.h"
+
+/**
+ * Największa liczba wątków, którą można podać w argumentach programu.
+ */
+#define MAX_THREADS 1024
+
+/**
+ * @brief Wczytuje argumenty programu.
+ * Dopuszczalnymi argumentami, każdy najwyżej raz, są:
+ *  - @c -t @c N, gdzie @c N to liczba wątków (od @c 1 do @ref MAX_THREADS)
+ *    puli używanej do obliczania @c NTRIV (@ref phfwdPoolNew);
+ *  - @c -p, który włącza wczytywanie operacji w osobnym wątku
+ *    (@ref pipelineRun);
+ *  - @c -w @c N, gdzie @c N to liczba wątków (od @c 1 do @ref MAX_THREADS)
+ *    wykonujących równolegle operacje na różnych bazach, co włącza też
+ *    @c -p.
+ * @param argc – liczba argumentów programu;
+ * @param argv – tablica argumentów programu;
+ * @param[out] threads – wskaźnik na zmienną, do której zostanie zapisana
+ *                       liczba wątków;
+ * @param[out] pipelined – wskaźnik na zmienną, do której zostanie zapisana
+ *                         informacja, czy podano @c -p, lub @c -w;
+ * @param[out] workers – wskaźnik na zmienną, do której zostanie zapisana
+ *                       liczba wątków baz, lub @c 0, jeśli nie podano
+ *                       @c -w.
+ * @return Wartość @c true, jeśli argumenty są poprawne, lub wartość
+ *         @c false w przeciwnym przypadku.
+ */
+static bool readArguments(int argc, char *argv[], unsigned *threads,
+                          bool *pipelined, unsigned *workers) {
+    unsigned long value;
+    bool threadsRead, pipelinedRead;
+    char *end;
+    int i;
+
+    // Domyślnie wszystko jest liczone w jednym wątku
+    *threads = 1;
+    *pipelined = false;
+    *workers = 0;
+    threadsRead = false;
+    pipelinedRead = false;
+    for (i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-p") == 0 && !pipelinedRead) {
+            *pipelined = true;
+            pipelinedRead = true;
+            continue;
+        }
+        if (i + 1 == argc)
+            return false;
+        if ((strcmp(argv[i], "-t") != 0 || threadsRead) &&
+            (strcmp(argv[i], "-w") != 0 || *workers != 0))
+            return false;
+
+        // Sprawdzenie poprawności liczby wątków
+        if (argv[i + 1][0] < '0' || argv[i + 1][0] > '9')
+            return false;
+        value = strtoul(argv[i + 1], &end, 10);
+        if (*end != '\0' || value == 0 || value > MAX_THREADS)
+            return false;
+        if (strcmp(argv[i], "-t") == 0) {
+            *threads = (unsigned) value;
+            threadsRead = true;
+        } else {
+            *workers = (unsigned) value;
+            *pipelined = true;
+        }
+        i++;
+    }
+    return true;
+}
 
 /**
  * Główna funkcja programu
+ * @param argc – liczba argumentów programu;
+ * @param argv – tablica argumentów programu.
  * @return Wartość @c 0 jeśli program zakończył się bez błędów i @c 1 jeśli
  *         zakończył się z błędem.
  */
-int main() {
+int main(int argc, char *argv[]) {
     struct Dictionary *dictionary;
     struct PhoneForward *phoneForward;
     struct Operation *nextOperation;
+    struct PhoneForwardPool *pool;
     int inputCharacterNumber;
     int programmeOutput;
     int operationOptput;
+    unsigned threads;
+    unsigned workers;
+    bool pipelined;
+
+    // Wczytanie argumentów programu
+    if (!readArguments(argc, argv, &threads, &pipelined, &workers)) {
+        fprintf(stderr, "ERROR usage: %s [-t threads] [-p] [-w workers]\n",
+                argv[0]);
+        return 1;
+    }
 
     // Ustawienie ostatniego wczytanego znaku na znak zerowy
     inputCharacterNumber = 0;
@@ -51,6 +138,27 @@ int main() {
         return 1;
     }
 
+    /*
+     * Stworzenie puli wątków dla NTRIV, jeśli wybrano więcej niż jeden wątek.
+     * Jeśli nie udało się jej stworzyć, to NTRIV jest liczone w jednym wątku.
+     */
+    pool = threads > 1 ? phfwdPoolNew(threads) : NULL;
+
+    /*
+     * Wykonanie z wczytywaniem w osobnym wątku, jeśli zostało wybrane. Jeśli
+     * nie udało się uruchomić wątku, to operacje są wykonywane kolejno.
+     */
+    if (pipelined) {
+        programmeOutput = pipelineRun(dictionary, pool, workers);
+        if (programmeOutput >= 0) {
+            operationDestroy(nextOperation);
+            dictionaryDestroy(dictionary);
+            phfwdPoolDelete(pool);
+            return programmeOutput;
+        }
+        programmeOutput = 0;
+    }
+
     while (inputReaderReadNextOperation(nextOperation, &inputCharacterNumber)) {
 
         /*
@@ -59,38 +167,11 @@ int main() {
          * zakończenie programu
          */
         if ((operationOptput =
-                     operationExecute(nextOperation, &phoneForward, dictionary))
+                     operationExecute(nextOperation, &phoneForward, dictionary,
+                                      pool))
             != OPERATION_SUCCESS) {
 
-            switch (operationOptput) {
-
-                // Napodkany przedwcześnie EOF
-                case EOF_ERROR:
-                    fprintf(stderr, "ERROR EOF\n");
-                    break;
-
-                // Błąd wykonania operacji
-                case OPERATION_ERROR:
-                    fprintf(stderr, "ERROR %s %d\n", nextOperation->operationName,
-                            nextOperation->firstSignNumber);
-                    break;
-
-                // Błąd parsowania operacji wejścia
-                case PARSING_ERROR:
-                    fprintf(stderr, "ERROR %d\n", nextOperation->firstSignNumber);
-                    break;
-
-                // Błąd pamięci
-                case MEMORY_ERROR:
-                    fprintf(stderr, "ERROR memory error\n");
-                    break;
-
-                // Nieznany błąd
-                default:
-                    // Informacja o nieznanym błędzie
-                    fprintf(stderr, "ERROR unknown error\n");
-                    break;
-            }
+            operationPrintError(nextOperation, operationOptput);
 
             // Jeśli wystąpił jakikolwiek błąd, to kończymy wykonanie programu
             programmeOutput = 1;
@@ -104,7 +185,9 @@ int main() {
     /*
      * Zwolnienie zaalokowanej pamięci i zakończenie wykonania programu
      */
+    outputWriterFlush();
     operationDestroy(nextOperation);
     dictionaryDestroy(dictionary);
+    phfwdPoolDelete(pool);
     return programmeOutput;
 }
\ No newline at end of file
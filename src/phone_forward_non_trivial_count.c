@@ -8,10 +8,30 @@
 
 #include <stdlib.h>
 #include <stdbool.h>
+#include <limits.h>
+#include <stdatomic.h>
 #include "phone_forward_struct.h"
 #include "phone_forward_list.h"
+#include "phone_forward_pool.h"
 #include "phone_forward_non_trivial_count.h"
 
+/**
+ * Początkowy rozmiar tablicy grup nietrywialnych wierzchołków.
+ */
+#define NON_TRIVIAL_INITIAL_CAPACITY 16
+
+/**
+ * Największa liczba poddrzew, na które jest dzielone równoległe przejście
+ * drzewa.
+ */
+#define NON_TRIVIAL_TASKS 256
+
+/**
+ * Docelowa liczba poddrzew przypadających na jeden wątek, żeby wątki, które
+ * skończą wcześniej, mogły przejąć pracę pozostałych.
+ */
+#define NON_TRIVIAL_TASKS_PER_THREAD 8
+
 /**
  * @brief Potęguje.
  * Oblicza @p b tą potęgę @p modulo @c 2 do potęgi liczba bitów reprezentacji
@@ -22,103 +42,636 @@
  *         reprezentacji typu @c size_t.
  */
 size_t nthPowerOf(size_t a, size_t b) {
-    size_t helper;
-    if (b == 0)
-        return 1;
-    helper = nthPowerOf(a, b / 2);
-    if (b % 2 == 0)
-        return helper * helper;
-    return helper * helper * a;
-}
-
-/**
- * @brief Funkcja oblicza liczbę nietrywialnych numerów.
- * Pomocnicza do @ref phoneForwardNonTrivialCount.
- * Funkcja oblicza liczbę nietrywialnych numerów długości len zawierających
- * tylko cyfry, które są oznaczone jako istniejące w @p doesCharacterExist.
- * Obliczenia wykonuje modulo @c 2 do potęgi liczba bitów reprezentacji typu
- * @c size_t.
- * @param[in] phoneForward  – wskaźnik na strukturę przechowującą przekierowania
- *                            numerów, który nie może mieć wartości @c NULL;
- * @param[out] phoneForward – wskaźnik na tą samą strukturę;
- * @param doesCharacterExist – wskaźnik na tablicę @c bool-i, która musi być
- *                             rozmiaru @ref SIZE_OF_ALPHABET, zawierającą
- *                             informację o istnieniu pocsczególnych cyfr;
- * @param count – liczba dozwolonch w tablicy @p doesCharacterExist;
- * @param length – długość zliczanych numerów telefonów na początku musząca być
- *                 różną od @c 0;
- * @param result – wskaźnik na zmienną do której ma zostać zapisany wynik do
- *                 zwrócenia, który na początku ma mieć wartość @c 0 i jest
- *                 akumulatorem.
- * @return Szukana liczba modulo @c 2 do potęgi liczba bitów reprezentacji typu
- *         @c size_t.
+    size_t result;
+
+    // Szybkie potęgowanie iteracyjne, od najmłodszego bitu wykładnika
+    for (result = 1; b > 0; b /= 2, a *= a)
+        if (b % 2 == 1)
+            result *= a;
+    return result;
+}
+
+/**
+ * @brief Wyznacza maskę cyfr etykiety.
+ * @param node – wskaźnik na wierzchołek.
+ * @return Maska, w której bit @c i jest zapalony, jeśli w etykiecie krawędzi
+ *         do wierzchołka @p node występuje znak @c FIRST_LETTER + @c i.
  */
-size_t phoneForwardNonTrivialCountProcessedParams(
-        struct PhoneForward *phoneForward, bool *doesCharacterExist,
-        size_t count, size_t length, size_t *result) {
+static uint32_t phoneForwardLabelMask(struct PhoneForwardNode const *node) {
+    uint32_t mask;
+    unsigned i;
+
+    mask = 0;
+    for (i = 0; i < node->labelLength; i++)
+        mask |= 1u << (node->label[i] - FIRST_LETTER);
+    return mask;
+}
+
+/**
+ * @brief Wyznacza pozycję w tablicy grup.
+ * @param depth – głębokość wierzchołków grupy;
+ * @param mask – maska cyfr grupy;
+ * @param capacity – rozmiar tablicy, będący potęgą dwójki.
+ * @return Pozycja, od której należy szukać grupy.
+ */
+static size_t phoneForwardNonTrivialHash(int depth, uint32_t mask,
+                                         size_t capacity) {
+    uint64_t key;
+
+    key = ((uint64_t) (unsigned) depth << SIZE_OF_ALPHABET | mask) *
+          UINT64_C(0x9E3779B97F4A7C15);
+    return (size_t) (key >> 32) & (capacity - 1);
+}
+
+/**
+ * @brief Znajduje grupę nietrywialnych wierzchołków.
+ * Jeśli grupy nie ma w tablicy, to ją tworzy - tablica musi mieć wtedy wolne
+ * miejsce zarezerwowane przez @ref phoneForwardNonTrivialReserve.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param depth – głębokość wierzchołków grupy;
+ * @param mask – maska cyfr grupy.
+ * @return Wskaźnik na grupę.
+ */
+static struct PhoneForwardNonTrivialEntry *phoneForwardNonTrivialEntry(
+        struct PhoneForward *phoneForward, int depth, uint32_t mask) {
+    struct PhoneForwardNonTrivialEntry *entry;
     size_t i;
 
-    // Sprawdzanie, czy numery poniżej są nietrywialne
-    if (!phoneForwardListIsEmpty(phoneForward->revert)) {
-        *result += nthPowerOf(count, length);
-        return *result;
+    i = phoneForwardNonTrivialHash(depth, mask,
+                                   phoneForward->nonTrivialCapacity);
+    for (;; i = (i + 1) & (phoneForward->nonTrivialCapacity - 1)) {
+        entry = phoneForward->nonTrivial + i;
+        if (entry->depth == depth && entry->mask == mask)
+            return entry;
+        if (entry->depth == 0)
+            break;
     }
 
-    // Jeśli skończyła się dozwolona liczba numerów
-    if (length == 0) {
-        return *result;
+    // Utworzenie pustej grupy w pierwszym wolnym miejscu
+    entry->depth = depth;
+    entry->mask = (uint16_t) mask;
+    if (depth > phoneForward->nonTrivialMaxDepth)
+        phoneForward->nonTrivialMaxDepth = depth;
+    entry->nodes = 0;
+    entry->first = 0;
+    phoneForward->nonTrivialUsed++;
+    return entry;
+}
+
+bool phoneForwardNonTrivialReserve(struct PhoneForward *phoneForward) {
+    struct PhoneForwardNonTrivialEntry *oldEntries;
+    size_t i, live, oldCapacity, newCapacity;
+
+    // Tablica jest wypełniona najwyżej w trzech czwartych
+    if ((phoneForward->nonTrivialUsed + 1) * 4 <=
+        phoneForward->nonTrivialCapacity * 3)
+        return true;
+
+    /*
+     * Przebudowanie tablicy bez pustych grup, tak żeby była wypełniona
+     * najwyżej w połowie.
+     */
+    live = 0;
+    for (i = 0; i < phoneForward->nonTrivialCapacity; i++)
+        if (phoneForward->nonTrivial[i].nodes > 0)
+            live++;
+    newCapacity = NON_TRIVIAL_INITIAL_CAPACITY;
+    while ((live + 1) * 2 > newCapacity)
+        newCapacity *= 2;
+
+    oldEntries = phoneForward->nonTrivial;
+    oldCapacity = phoneForward->nonTrivialCapacity;
+    phoneForward->nonTrivial =
+            calloc(newCapacity, sizeof(struct PhoneForwardNonTrivialEntry));
+    if (phoneForward->nonTrivial == NULL) {
+        phoneForward->nonTrivial = oldEntries;
+        return false;
     }
+    phoneForward->nonTrivialCapacity = newCapacity;
+    phoneForward->nonTrivialUsed = 0;
+    phoneForward->nonTrivialMaxDepth = 0;
+    for (i = 0; i < oldCapacity; i++)
+        if (oldEntries[i].nodes > 0)
+            *phoneForwardNonTrivialEntry(phoneForward, oldEntries[i].depth,
+                                         oldEntries[i].mask) = oldEntries[i];
+    free(oldEntries);
+    return true;
+}
+
+/**
+ * @brief Sprawdza, czy pod wierzchołkiem są nietrywialne wierzchołki.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – wskaźnik na wierzchołek.
+ * @return Wartość @c true, jeśli na poddrzewo któregoś z synów @p node jest
+ *         przekierowanie, lub @c false w przeciwnym przypadku.
+ */
+static bool phoneForwardNonTrivialBelow(struct PhoneForward *phoneForward,
+                                        struct PhoneForwardNode *node) {
+    uint32_t const *children;
+    unsigned i, count;
+
+    children = phoneForwardChildArray(phoneForward, node);
+    count = phoneForwardBitCount(node->childMask);
+    for (i = 0; i < count; i++)
+        if (phoneForwardNode(phoneForward, children[i])->revertCount > 0)
+            return true;
+    return false;
+}
+
+void phoneForwardNonTrivialUpdate(struct PhoneForward *phoneForward,
+                                  uint32_t node, bool added) {
+    struct PhoneForwardNode *nodePtr, *currentNode;
+    struct PhoneForwardNonTrivialEntry *entry;
+    uint32_t current, mask;
+    bool shadowed;
+    size_t delta;
 
-    // Wejście do kolejnych synów
-    for (i = 0; i < SIZE_OF_ALPHABET; i++) {
-        if (doesCharacterExist[i] && phoneForward->nextLetter[i] != NULL) {
-            phoneForwardNonTrivialCountProcessedParams(
-                    phoneForward->nextLetter[i], doesCharacterExist, count,
-                    length - 1, result);
+    /*
+     * Wyznaczenie maski cyfr numeru i sprawdzenie, czy któryś z jego
+     * właściwych prefiksów jest nietrywialny.
+     */
+    nodePtr = phoneForwardNode(phoneForward, node);
+    mask = 0;
+    shadowed = false;
+    for (current = node; current != PHONE_FORWARD_NULL;
+         current = currentNode->prev) {
+        currentNode = phoneForwardNode(phoneForward, current);
+        mask |= phoneForwardLabelMask(currentNode);
+        if (current != node && !phoneForwardListIsEmpty(currentNode->revert))
+            shadowed = true;
+    }
+
+    delta = added ? 1 : SIZE_MAX;
+    entry = phoneForwardNonTrivialEntry(phoneForward, nodePtr->depth, mask);
+    entry->nodes += delta;
+    if (shadowed)
+        return;
+    entry->first += delta;
+
+    /*
+     * Wierzchołek staje się (lub przestaje być) najpłytszym nietrywialnym
+     * wierzchołkiem na swojej ścieżce, więc nietrywialne wierzchołki poniżej
+     * przestają (lub zaczynają) nimi być. Zamiast poprawiać je teraz, co
+     * wymagałoby przejścia poddrzewa, zostaną wyznaczone od nowa przy
+     * następnym zliczaniu.
+     */
+    if (phoneForwardNonTrivialBelow(phoneForward, nodePtr))
+        phoneForward->nonTrivialStale = true;
+}
+
+/**
+ * @brief Sprawdza, czy przejście drzewa schodzi do wierzchołka.
+ * @param node – wskaźnik na wierzchołek różny od korzenia;
+ * @param setMask – maska dozwolonych cyfr;
+ * @param maxDepth – największa głębokość przechodzonych wierzchołków.
+ * @return Wartość @c true, jeśli na poddrzewo wierzchołka są przekierowania,
+ *         jego etykieta składa się z dozwolonych cyfr i nie jest on głębiej
+ *         niż @p maxDepth, lub @c false w przeciwnym przypadku.
+ */
+static bool phoneForwardNonTrivialVisited(struct PhoneForwardNode const *node,
+                                          uint32_t setMask, size_t maxDepth) {
+    return node->revertCount > 0 && (size_t) node->depth <= maxDepth &&
+           (phoneForwardLabelMask(node) & ~setMask) == 0;
+}
+
+/**
+ * @brief Przechodzi pierwsze nietrywialne wierzchołki poddrzewa.
+ * Przechodzi poddrzewo wierzchołka @p start (bez niego samego) bez stosu, w
+ * kolejności synów, schodząc tylko do wierzchołków wskazanych przez
+ * @ref phoneForwardNonTrivialVisited. Zatrzymuje się na pierwszym
+ * nietrywialnym wierzchołku każdej ścieżki.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param start – indeks trywialnego wierzchołka, od którego zaczyna się
+ *                przejście;
+ * @param setMask – maska dozwolonych cyfr;
+ * @param maxDepth – największa głębokość przechodzonych wierzchołków;
+ * @param powers – tablica rozmiaru @p maxDepth + 1, której element @c d jest
+ *                 dodawany do wyniku dla każdego znalezionego wierzchołka
+ *                 głębokości @c d, lub @c NULL, jeśli zamiast tego ma być
+ *                 zwiększane pole @p first grupy znalezionego wierzchołka.
+ * @return Suma elementów @p powers modulo @c 2 do potęgi liczba bitów
+ *         reprezentacji typu @c size_t, lub @c 0, jeśli @p powers ma wartość
+ *         @c NULL.
+ */
+static size_t phoneForwardNonTrivialWalk(struct PhoneForward *phoneForward,
+                                         uint32_t start, uint32_t setMask,
+                                         size_t maxDepth,
+                                         size_t const *powers) {
+    struct PhoneForwardNode *nodePtr, *childNode, *currentNode;
+    uint32_t const *children;
+    uint32_t node, child, current, mask;
+    unsigned position, count, letter;
+    size_t result;
+
+    result = 0;
+    node = start;
+    position = 0;
+    for (;;) {
+        nodePtr = phoneForwardNode(phoneForward, node);
+        children = phoneForwardChildArray(phoneForward, nodePtr);
+        count = phoneForwardBitCount(nodePtr->childMask);
+
+        // Następny syn, do którego trzeba zejść
+        for (; position < count; position++) {
+            childNode = phoneForwardNode(phoneForward, children[position]);
+            if (phoneForwardNonTrivialVisited(childNode, setMask, maxDepth))
+                break;
         }
+
+        if (position < count) {
+            child = children[position];
+            if (phoneForwardListIsEmpty(childNode->revert)) {
+                node = child;
+                position = 0;
+                continue;
+            }
+
+            // Pierwszy nietrywialny wierzchołek na ścieżce
+            position++;
+            if (powers != NULL) {
+                result += powers[childNode->depth];
+                continue;
+            }
+            mask = 0;
+            for (current = child; current != PHONE_FORWARD_NULL;
+                 current = currentNode->prev) {
+                currentNode = phoneForwardNode(phoneForward, current);
+                mask |= phoneForwardLabelMask(currentNode);
+            }
+            phoneForwardNonTrivialEntry(phoneForward, childNode->depth,
+                                        mask)->first++;
+            continue;
+        }
+
+        // Powrót do ojca, za pozycję bieżącego wierzchołka
+        if (node == start)
+            break;
+        letter = (unsigned) (nodePtr->label[0] - FIRST_LETTER);
+        node = nodePtr->prev;
+        position = phoneForwardBitCount(
+                phoneForwardNode(phoneForward, node)->childMask &
+                ((1u << letter) - 1)) + 1;
     }
-    return *result;
+
+    return result;
 }
 
-size_t phoneForwardNonTrivialCount(struct PhoneForward *phoneForward,
-                                   char const *set, size_t length) {
-    size_t i;
+/**
+ * @brief Równoległe przejście drzewa.
+ * Wspólne dane wątków wykonujących @ref phoneForwardNonTrivialJob.
+ */
+struct PhoneForwardNonTrivialTask {
+    /**@{*/
+
+    struct PhoneForward *phoneForward;
+    /**<
+     * Wskaźnik na bazę.
+     */
+
+    uint32_t setMask;
+    /**<
+     * Maska dozwolonych cyfr.
+     */
+
+    size_t maxDepth;
+    /**<
+     * Największa głębokość przechodzonych wierzchołków.
+     */
+
+    size_t const *powers;
+    /**<
+     * Tablica potęg rozmiaru @p maxDepth + 1.
+     */
+
+    uint32_t nodes[NON_TRIVIAL_TASKS];
+    /**<
+     * Wierzchołki, których poddrzewa są przechodzone osobno.
+     */
+
     size_t count;
-    size_t result;
-    bool doesCharacterExist[SIZE_OF_ALPHABET];
+    /**<
+     * Liczba wierzchołków w tablicy @p nodes.
+     */
 
-    /*
-     * Jeśli wskaźnik PhoneForward ma wartość NULL, set ma wartość NULL, set
-     * jest pusty, lub parametr length jest równy zeru, wynikiem jest zero.
+    atomic_size_t next;
+    /**<
+     * Pozycja następnego nieprzydzielonego wierzchołka tablicy @p nodes.
      */
-    if (phoneForward == NULL || set == NULL || set[0] == '\0' || length == 0)
-        return 0;
 
-    // Przygotowanie wartości
-    count = 0;
-    for (i = 0; i < SIZE_OF_ALPHABET; i++) {
-        doesCharacterExist[i] = false;
+    atomic_size_t result;
+    /**<
+     * Suma wyników przetworzonych poddrzew.
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Dzieli przejście drzewa na poddrzewa.
+ * Zaczyna od synów korzenia i, dopóki poddrzew jest mniej niż
+ * @p target, zastępuje trywialny wierzchołek z największą liczbą przekierowań
+ * na poddrzewo jego synami, więc jedno dominujące poddrzewo jest dzielone
+ * dalej.
+ * @param task – wskaźnik na zadanie z ustawioną bazą, maską i głębokością;
+ * @param target – docelowa liczba poddrzew, nie większa niż
+ *                 @ref NON_TRIVIAL_TASKS.
+ */
+static void phoneForwardNonTrivialSplit(struct PhoneForwardNonTrivialTask *task,
+                                        size_t target) {
+    struct PhoneForwardNode *nodePtr, *childNode;
+    uint32_t const *children;
+    uint32_t node;
+    unsigned i, count, visited;
+    size_t j, best;
+
+    task->count = 0;
+    node = PHONE_FORWARD_ROOT;
+    for (;;) {
+        // Dopisanie synów, do których schodzi przejście
+        nodePtr = phoneForwardNode(task->phoneForward, node);
+        children = phoneForwardChildArray(task->phoneForward, nodePtr);
+        count = phoneForwardBitCount(nodePtr->childMask);
+        for (i = 0; i < count; i++) {
+            childNode = phoneForwardNode(task->phoneForward, children[i]);
+            if (phoneForwardNonTrivialVisited(childNode, task->setMask,
+                                              task->maxDepth))
+                task->nodes[task->count++] = children[i];
+        }
+        if (task->count >= target)
+            return;
+
+        // Wybór największego poddrzewa, które można podzielić
+        best = task->count;
+        for (j = 0; j < task->count; j++) {
+            nodePtr = phoneForwardNode(task->phoneForward, task->nodes[j]);
+            if (phoneForwardListIsEmpty(nodePtr->revert) &&
+                (best == task->count || nodePtr->revertCount >
+                 phoneForwardNode(task->phoneForward,
+                                  task->nodes[best])->revertCount))
+                best = j;
+        }
+        if (best == task->count)
+            return;
+
+        // Synowie muszą się zmieścić w tablicy
+        nodePtr = phoneForwardNode(task->phoneForward, task->nodes[best]);
+        children = phoneForwardChildArray(task->phoneForward, nodePtr);
+        count = phoneForwardBitCount(nodePtr->childMask);
+        for (visited = 0, i = 0; i < count; i++)
+            if (phoneForwardNonTrivialVisited(
+                    phoneForwardNode(task->phoneForward, children[i]),
+                    task->setMask, task->maxDepth))
+                visited++;
+        if (task->count - 1 + visited > NON_TRIVIAL_TASKS)
+            return;
+
+        // Zastąpienie wierzchołka jego synami
+        node = task->nodes[best];
+        task->nodes[best] = task->nodes[--task->count];
+    }
+}
+
+/**
+ * @brief Przechodzi kolejne nieprzydzielone poddrzewa zadania.
+ * Wywoływana równocześnie we wszystkich wątkach puli. Wyniki poddrzew są
+ * sumowane lokalnie i dodawane do wyniku zadania na końcu.
+ * @param argument – wskaźnik na strukturę @ref PhoneForwardNonTrivialTask.
+ */
+static void phoneForwardNonTrivialJob(void *argument) {
+    struct PhoneForwardNonTrivialTask *task;
+    struct PhoneForwardNode *nodePtr;
+    size_t i, result;
+
+    task = argument;
+    result = 0;
+    while ((i = atomic_fetch_add(&task->next, 1)) < task->count) {
+        nodePtr = phoneForwardNode(task->phoneForward, task->nodes[i]);
+        if (!phoneForwardListIsEmpty(nodePtr->revert))
+            result += task->powers[nodePtr->depth];
+        else
+            result += phoneForwardNonTrivialWalk(task->phoneForward,
+                                                 task->nodes[i], task->setMask,
+                                                 task->maxDepth, task->powers);
     }
+    atomic_fetch_add(&task->result, result);
+}
+
+/**
+ * @brief Sumuje pierwsze nietrywialne wierzchołki w wątkach puli.
+ * Działa jak @ref phoneForwardNonTrivialWalk od korzenia, ale dzieli drzewo
+ * na poddrzewa przechodzone przez wątki puli @p pool.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param setMask – maska dozwolonych cyfr;
+ * @param maxDepth – największa głębokość przechodzonych wierzchołków;
+ * @param powers – tablica potęg rozmiaru @p maxDepth + 1;
+ * @param pool – wskaźnik na pulę wątków, lub @c NULL.
+ * @return Suma elementów @p powers modulo @c 2 do potęgi liczba bitów
+ *         reprezentacji typu @c size_t.
+ */
+static size_t phoneForwardNonTrivialWalkParallel(
+        struct PhoneForward *phoneForward, uint32_t setMask, size_t maxDepth,
+        size_t const *powers, struct PhoneForwardPool *pool) {
+    struct PhoneForwardNonTrivialTask task;
+    size_t target;
+
+    if (pool == NULL)
+        return phoneForwardNonTrivialWalk(phoneForward, PHONE_FORWARD_ROOT,
+                                          setMask, maxDepth, powers);
+
+    task.phoneForward = phoneForward;
+    task.setMask = setMask;
+    task.maxDepth = maxDepth;
+    task.powers = powers;
+    target = (size_t) phoneForwardPoolSize(pool) *
+             NON_TRIVIAL_TASKS_PER_THREAD;
+    phoneForwardNonTrivialSplit(&task, target < NON_TRIVIAL_TASKS
+                                       ? target : NON_TRIVIAL_TASKS);
+    atomic_init(&task.next, 0);
+    atomic_init(&task.result, 0);
+
+    phoneForwardPoolRun(pool, phoneForwardNonTrivialJob, &task);
+    return atomic_load(&task.result);
+}
+
+/**
+ * @brief Wyznacza od nowa liczby pierwszych nietrywialnych wierzchołków.
+ * @param phoneForward – wskaźnik na bazę.
+ */
+static void phoneForwardNonTrivialRebuild(struct PhoneForward *phoneForward) {
+    size_t i;
+
+    for (i = 0; i < phoneForward->nonTrivialCapacity; i++)
+        phoneForward->nonTrivial[i].first = 0;
+    phoneForwardNonTrivialWalk(phoneForward, PHONE_FORWARD_ROOT,
+                               (1u << SIZE_OF_ALPHABET) - 1, SIZE_MAX, NULL);
+    phoneForward->nonTrivialStale = false;
+}
+
+/**
+ * @brief Wyznacza maskę cyfr napisu.
+ * @param set – wskaźnik na napis;
+ * @param[out] count – wskaźnik na zmienną, do której zostanie zapisana liczba
+ *                     różnych cyfr napisu.
+ * @return Maska, w której bit @c i jest zapalony, jeśli w napisie występuje
+ *         znak @c FIRST_LETTER + @c i.
+ */
+static uint32_t phoneForwardNonTrivialSetMask(char const *set, size_t *count) {
+    uint32_t setMask;
+    size_t i;
+
+    // Przygotowanie wartości
+    *count = 0;
+    setMask = 0;
 
     // Zapisanie które cyfry numeru są w set i ich zliczenie
     for (i = 0; set[i] != '\0'; i++) {
 
         if (FIRST_LETTER <= set[i] && set[i] <= LAST_LETTER &&
-            !doesCharacterExist[set[i] - FIRST_LETTER]) {
+            (setMask & 1u << (set[i] - FIRST_LETTER)) == 0) {
             // Dodanie informacji o wcześniej nienapotkanej cyfry
-            doesCharacterExist[set[i] - FIRST_LETTER] = true;
-            count++;
+            setMask |= 1u << (set[i] - FIRST_LETTER);
+            (*count)++;
         }
     }
+    return setMask;
+}
+
+/**
+ * @brief Oblicza liczbę nietrywialnych numerów bez tablicy potęg.
+ * Pomocnicza do @ref phoneForwardNonTrivialCount, gdy nie udało się
+ * zaalokować tablicy potęg.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param setMask – maska dozwolonych cyfr;
+ * @param count – liczba dozwolonych cyfr;
+ * @param length – długość zliczanych numerów.
+ * @return Szukana liczba modulo @c 2 do potęgi liczba bitów reprezentacji typu
+ *         @c size_t.
+ */
+static size_t phoneForwardNonTrivialCountSlow(
+        struct PhoneForward *phoneForward, uint32_t setMask, size_t count,
+        size_t length) {
+    struct PhoneForwardNonTrivialEntry const *entry;
+    size_t i, result;
+
+    result = 0;
+    for (i = 0; i < phoneForward->nonTrivialCapacity; i++) {
+        entry = phoneForward->nonTrivial + i;
+        if (entry->first == 0 || (entry->mask & ~setMask) != 0 ||
+            (size_t) entry->depth > length)
+            continue;
+        result += entry->first *
+                  nthPowerOf(count, length - (size_t) entry->depth);
+    }
+    return result;
+}
+
+/**
+ * @brief Oblicza liczbę nietrywialnych numerów.
+ * Pomocnicza do @ref phoneForwardNonTrivialCount. Każdy najpłytszy
+ * nietrywialny wierzchołek złożony z dozwolonych cyfr, nie głębszy niż
+ * @p length, jest prefiksem @p count do potęgi pozostałej długości
+ * nietrywialnych numerów. Grupy są wybierane bez rozgałęzień - pominięte
+ * dodają zero.
+ * Jeśli pola @p first grup są nieaktualne, to pierwsze zliczanie po zmianie
+ * przechodzi tylko pasujące fragmenty drzewa, a dopiero kolejne wyznacza je
+ * od nowa, bo wtedy tablica grup zostanie użyta więcej niż raz. Tylko to
+ * pierwsze przejście jest dzielone między wątki puli @p pool.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param setMask – niepusta maska dozwolonych cyfr;
+ * @param count – liczba dozwolonych cyfr;
+ * @param length – niezerowa długość zliczanych numerów;
+ * @param pool – wskaźnik na pulę wątków, lub @c NULL.
+ * @return Szukana liczba modulo @c 2 do potęgi liczba bitów reprezentacji typu
+ *         @c size_t.
+ */
+static size_t phoneForwardNonTrivialCompute(struct PhoneForward *phoneForward,
+                                            uint32_t setMask, size_t count,
+                                            size_t length,
+                                            struct PhoneForwardPool *pool) {
+    struct PhoneForwardNonTrivialEntry const *entry;
+    size_t i, maxDepth, keep, result;
+    size_t *powers;
+
+    /*
+     * Tablica potęg - powers[d] to count do potęgi length - d, dla głębokości
+     * d, na których mogą leżeć zliczane grupy.
+     */
+    maxDepth = (size_t) phoneForward->nonTrivialMaxDepth;
+    if (maxDepth > length)
+        maxDepth = length;
+    powers = malloc((maxDepth + 1) * sizeof(size_t));
+    if (powers == NULL) {
+        if (phoneForward->nonTrivialStale)
+            phoneForwardNonTrivialRebuild(phoneForward);
+        return phoneForwardNonTrivialCountSlow(phoneForward, setMask, count,
+                                               length);
+    }
+    powers[maxDepth] = nthPowerOf(count, length - maxDepth);
+    for (i = maxDepth; i > 0; i--)
+        powers[i - 1] = powers[i] * count;
+
+    if (phoneForward->nonTrivialStale &&
+        phoneForward->nonTrivialWalkVersion != phoneForward->version) {
+        phoneForward->nonTrivialWalkVersion = phoneForward->version;
+        result = phoneForwardNonTrivialWalkParallel(phoneForward, setMask,
+                                                    maxDepth, powers, pool);
+        free(powers);
+        return result;
+    }
+    if (phoneForward->nonTrivialStale)
+        phoneForwardNonTrivialRebuild(phoneForward);
+
+    result = 0;
+    for (i = 0; i < phoneForward->nonTrivialCapacity; i++) {
+        entry = phoneForward->nonTrivial + i;
+        keep = (size_t) (((entry->mask & ~setMask) == 0) &
+                         ((size_t) entry->depth <= maxDepth));
+        result += keep * entry->first * powers[keep * (size_t) entry->depth];
+    }
+    free(powers);
+
+    return result;
+}
+
+size_t phoneForwardNonTrivialCount(struct PhoneForward *phoneForward,
+                                   char const *set, size_t length) {
+    return phoneForwardNonTrivialCountParallel(phoneForward, set, length, NULL);
+}
+
+size_t phoneForwardNonTrivialCountParallel(struct PhoneForward *phoneForward,
+                                           char const *set, size_t length,
+                                           struct PhoneForwardPool *pool) {
+    struct PhoneForwardNonTrivialCacheEntry *cached;
+    uint32_t setMask;
+    size_t count;
+
+    /*
+     * Jeśli wskaźnik PhoneForward ma wartość NULL, set ma wartość NULL, set
+     * jest pusty, lub parametr length jest równy zeru, wynikiem jest zero.
+     */
+    if (phoneForward == NULL || set == NULL || set[0] == '\0' || length == 0)
+        return 0;
 
     // Jeśli set nie zawiera żadnej cyfry wynikiem jest zero
+    setMask = phoneForwardNonTrivialSetMask(set, &count);
     if (count == 0)
         return 0;
 
-    // Przygotowanie wyniku
-    result = 0;
+    /*
+     * Wynik zależy tylko od zbioru cyfr i długości, więc jest zapamiętywany
+     * do następnej zmiany przekierowań w bazie.
+     */
+    cached = phoneForward->nonTrivialCache +
+             phoneForwardNonTrivialHash((int) (length % INT_MAX), setMask,
+                                        NON_TRIVIAL_CACHE_SIZE);
+    if (cached->version == phoneForward->version && cached->mask == setMask &&
+        cached->length == length)
+        return cached->result;
 
-    // Zwrócenie szukanej wartości
-    return phoneForwardNonTrivialCountProcessedParams(
-            phoneForward, doesCharacterExist, count, length, &result);
+    cached->result = phoneForwardNonTrivialCompute(phoneForward, setMask,
+                                                   count, length, pool);
+    cached->version = phoneForward->version;
+    cached->mask = setMask;
+    cached->length = length;
+    return cached->result;
 }
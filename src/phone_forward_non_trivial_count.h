@@ -10,14 +10,40 @@
 #define TELEFONY_PHONE_FORWARD_NON_TRIVIAL_COUNT_H
 
 #include <stdlib.h>
+#include <stdbool.h>
 #include "phone_forward_struct.h"
+#include "phone_forward_pool.h"
+
+/**
+ * @brief Rezerwuje miejsce na nową grupę nietrywialnych wierzchołków.
+ * Musi zostać wywołana przed zmianą, po której wierzchołek może stać się
+ * nietrywialny.
+ * @param phoneForward – wskaźnik na bazę.
+ * @return Wartość @c true, jeśli w tablicy grup jest wolne miejsce, lub
+ *         wartość @c false, jeśli nie udało się zaalokować pamięci.
+ */
+bool phoneForwardNonTrivialReserve(struct PhoneForward *phoneForward);
+
+/**
+ * @brief Uaktualnia grupy nietrywialnych wierzchołków.
+ * Wywoływana, gdy lista odwrotności przekierowań wierzchołka przestaje być
+ * pusta (@p added równe @c true), lub staje się pusta (@p added równe
+ * @c false). Liczniki przekierowań w poddrzewach muszą być już uaktualnione.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks wierzchołka;
+ * @param added – informacja, czy wierzchołek staje się nietrywialny.
+ */
+void phoneForwardNonTrivialUpdate(struct PhoneForward *phoneForward,
+                                  uint32_t node, bool added);
 
 /** @brief Funkcja oblicza liczbę nietrywialnych numerów.
  * Działa jak @ref phfwdNonTrivialCount.
  * Funkcja oblicza liczbę nietrywialnych numerów długości len zawierających
  * tylko cyfry, które znajdują się w napisie set. Obliczenia wykonuje modulo
  * @c 2 do potęgi liczba bitów reprezentacji typu @c size_t. Napis @p set może
- * zawierać dowolne znaki.
+ * zawierać dowolne znaki. Zmienia zapamiętane wyniki i grupy nietrywialnych
+ * wierzchołków bazy, więc nie jest bezpieczna przy jednoczesnym użyciu bazy
+ * przez inne wątki.
  * @param[in] phoneForward  – wskaźnik na strukturę przechowującą przekierowania
  *                            numerów;
  * @param[out] phoneForward – wskaźnik na tą samą strukturę;
@@ -32,4 +58,19 @@
 size_t phoneForwardNonTrivialCount(struct PhoneForward *phoneForward,
                                    char const *set, size_t length);
 
+/** @brief Funkcja oblicza liczbę nietrywialnych numerów w wątkach puli.
+ * Działa jak @ref phoneForwardNonTrivialCount, ale pierwsze przejście drzewa
+ * po zmianie dzieli na poddrzewa przechodzone przez wątki puli @p pool.
+ * @param[in] phoneForward  – wskaźnik na strukturę przechowującą przekierowania
+ *                            numerów;
+ * @param[out] phoneForward – wskaźnik na tą samą strukturę;
+ * @param set – wskaźnik na napis;
+ * @param length – długość zliczanych numerów telefonów;
+ * @param pool – wskaźnik na pulę wątków, lub @c NULL.
+ * @return Taka sama wartość, jak @ref phoneForwardNonTrivialCount.
+ */
+size_t phoneForwardNonTrivialCountParallel(struct PhoneForward *phoneForward,
+                                           char const *set, size_t length,
+                                           struct PhoneForwardPool *pool);
+
 #endif //TELEFONY_PHONE_FORWARD_NON_TRIVIAL_COUNT_H
@@ -0,0 +1,203 @@
+/** @file
+ * Implementacja puli wątków z interfejsem w pliku @ref phone_forward_pool.h
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <pthread.h>
+#include "phone_forward_pool.h"
+
+/**
+ * @brief Pula wątków.
+ * Wątki puli czekają na kolejne zadania, więc nie są tworzone przy każdym
+ * zleceniu.
+ */
+struct PhoneForwardPool {
+    /**@{*/
+
+    pthread_mutex_t busy;
+    /**<
+     * Muteks trzymany przez wątek, który zlecił aktualne zadanie.
+     */
+
+    pthread_mutex_t mutex;
+    /**<
+     * Muteks chroniący pozostałe pola.
+     */
+
+    pthread_cond_t start;
+    /**<
+     * Zmienna warunkowa, na której wątki puli czekają na zadanie.
+     */
+
+    pthread_cond_t done;
+    /**<
+     * Zmienna warunkowa, na której wątek zlecający czeka na koniec zadania.
+     */
+
+    void (*job)(void *);
+    /**<
+     * Funkcja wykonująca aktualne zadanie.
+     */
+
+    void *argument;
+    /**<
+     * Argument aktualnego zadania.
+     */
+
+    uint64_t generation;
+    /**<
+     * Numer aktualnego zadania, zwiększany przy każdym zleceniu.
+     */
+
+    unsigned running;
+    /**<
+     * Liczba wątków puli, które nie skończyły jeszcze aktualnego zadania.
+     */
+
+    bool stopping;
+    /**<
+     * Informacja, czy wątki mają zakończyć pracę.
+     */
+
+    unsigned count;
+    /**<
+     * Liczba uruchomionych wątków puli.
+     */
+
+    pthread_t threads[];
+    /**<
+     * Identyfikatory uruchomionych wątków puli.
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Wykonuje kolejne zadania puli.
+ * @param argument – wskaźnik na pulę.
+ * @return Wartość @c NULL.
+ */
+static void *phoneForwardPoolWork(void *argument) {
+    struct PhoneForwardPool *pool;
+    uint64_t seen;
+    void (*job)(void *);
+    void *jobArgument;
+
+    /*
+     * Wątek mógł zostać uruchomiony już po zleceniu pierwszego zadania, więc
+     * zaczyna od numeru, który pula miała przy tworzeniu.
+     */
+    pool = argument;
+    seen = 0;
+    pthread_mutex_lock(&pool->mutex);
+    while (true) {
+        while (!pool->stopping && pool->generation == seen)
+            pthread_cond_wait(&pool->start, &pool->mutex);
+        if (pool->stopping)
+            break;
+        seen = pool->generation;
+        job = pool->job;
+        jobArgument = pool->argument;
+        pthread_mutex_unlock(&pool->mutex);
+
+        job(jobArgument);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->running == 0)
+            pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+    return NULL;
+}
+
+struct PhoneForwardPool *phoneForwardPoolCreate(unsigned threads) {
+    struct PhoneForwardPool *pool;
+
+    if (threads < 2)
+        return NULL;
+    pool = malloc(sizeof(struct PhoneForwardPool) +
+                  (threads - 1) * sizeof(pthread_t));
+    if (pool == NULL)
+        return NULL;
+
+    pthread_mutex_init(&pool->busy, NULL);
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+    pool->job = NULL;
+    pool->argument = NULL;
+    pool->generation = 0;
+    pool->running = 0;
+    pool->stopping = false;
+
+    // Uruchomienie wątków - pula korzysta z tych, które udało się uruchomić
+    for (pool->count = 0; pool->count < threads - 1; pool->count++)
+        if (pthread_create(&pool->threads[pool->count], NULL,
+                           phoneForwardPoolWork, pool) != 0)
+            break;
+    if (pool->count == 0) {
+        phoneForwardPoolDestroy(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void phoneForwardPoolDestroy(struct PhoneForwardPool *pool) {
+    unsigned i;
+
+    if (pool == NULL)
+        return;
+
+    // Zatrzymanie wątków
+    pthread_mutex_lock(&pool->mutex);
+    pool->stopping = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+    for (i = 0; i < pool->count; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->start);
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_mutex_destroy(&pool->busy);
+    free(pool);
+}
+
+unsigned phoneForwardPoolSize(struct PhoneForwardPool const *pool) {
+    if (pool == NULL)
+        return 1;
+    return pool->count + 1;
+}
+
+void phoneForwardPoolRun(struct PhoneForwardPool *pool, void (*job)(void *),
+                         void *argument) {
+    // Pula zajęta przez inny wątek nie jest używana
+    if (pool == NULL || pthread_mutex_trylock(&pool->busy) != 0) {
+        job(argument);
+        return;
+    }
+
+    // Zlecenie zadania wątkom puli
+    pthread_mutex_lock(&pool->mutex);
+    pool->job = job;
+    pool->argument = argument;
+    pool->running = pool->count;
+    pool->generation++;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+
+    // Bieżący wątek też wykonuje zadanie
+    job(argument);
+
+    // Czekanie na wątki puli
+    pthread_mutex_lock(&pool->mutex);
+    while (pool->running > 0)
+        pthread_cond_wait(&pool->done, &pool->mutex);
+    pthread_mutex_unlock(&pool->mutex);
+    pthread_mutex_unlock(&pool->busy);
+}
@@ -0,0 +1,56 @@
+/** @file
+ * Interfejs puli wątków wykonujących obliczenia na bazie przekierowań z
+ * implementacją w pliku @ref phone_forward_pool.c
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#ifndef TELEFONY_PHONE_FORWARD_POOL_H
+#define TELEFONY_PHONE_FORWARD_POOL_H
+
+#include "phone_forward.h"
+
+/**
+ * @brief Tworzy pulę wątków.
+ * Uruchamia @p threads - @c 1 wątków, które czekają na zadania - wątek
+ * zlecający zadanie też je wykonuje. Jeśli nie uda się uruchomić wszystkich
+ * wątków, to pula korzysta z tych, które zostały uruchomione.
+ * @param threads – łączna liczba wątków wykonujących zadanie.
+ * @return Wskaźnik na pulę, lub @c NULL, jeśli @p threads jest mniejsze od
+ *         @c 2, nie udało się zaalokować pamięci, lub nie udało się uruchomić
+ *         żadnego wątku.
+ */
+struct PhoneForwardPool *phoneForwardPoolCreate(unsigned threads);
+
+/**
+ * @brief Usuwa pulę wątków.
+ * Zatrzymuje i dołącza wątki puli, a następnie zwalnia pamięć. Nic nie robi,
+ * jeśli @p pool ma wartość @c NULL.
+ * @param pool – wskaźnik na pulę.
+ */
+void phoneForwardPoolDestroy(struct PhoneForwardPool *pool);
+
+/**
+ * @brief Podaje liczbę wątków puli.
+ * @param pool – wskaźnik na pulę, lub @c NULL.
+ * @return Liczba wątków wykonujących zadanie, razem z wątkiem zlecającym, lub
+ *         @c 1, jeśli @p pool ma wartość @c NULL.
+ */
+unsigned phoneForwardPoolSize(struct PhoneForwardPool const *pool);
+
+/**
+ * @brief Wykonuje zadanie we wszystkich wątkach puli.
+ * Wywołuje @p job z argumentem @p argument w każdym wątku puli i w wątku
+ * wywołującym, a następnie czeka, aż wszystkie wywołania się zakończą.
+ * Zadanie musi samo dzielić pracę między równoczesne wywołania. Jeśli pula
+ * jest w tym czasie używana przez inny wątek, lub ma wartość @c NULL, to
+ * zadanie jest wykonywane tylko w wątku wywołującym.
+ * @param pool – wskaźnik na pulę, lub @c NULL;
+ * @param job – funkcja wykonująca zadanie;
+ * @param argument – argument przekazywany do @p job.
+ */
+void phoneForwardPoolRun(struct PhoneForwardPool *pool, void (*job)(void *),
+                         void *argument);
+
+#endif //TELEFONY_PHONE_FORWARD_POOL_H
@@ -7,43 +7,103 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "phone_forward_remove.h"
 #include "phone_forward_struct.h"
 #include "phone_forward_list.h"
 
 /**
  * @brief Usuwa przekierowania w drzewie
- * Usuwa wszystkie przekierowania w danym drzewie.
- * @param[in] phoneForward – drzewo do usunięcia przekierowań;
- * @param[out] phoneForward – drzewo z usuniętymi przekierowaniami.
+ * Usuwa wszystkie przekierowania w danym drzewie. Pomija poddrzewa bez
+ * przekierowań, w których najgłębszy wierzchołek z przekierowaniem już ma
+ * docelową wartość.
+ * @param[in] phoneForward – baza zawierająca drzewo;
+ * @param[out] phoneForward – baza z usuniętymi przekierowaniami w drzewie;
+ * @param node – indeks korzenia drzewa do usunięcia przekierowań;
+ * @param forwardAncestor – najgłębszy wierzchołek z przekierowaniem powyżej
+ *                          drzewa, który staje się nim dla całego drzewa.
  */
-void phoneForwardCleanAll(struct PhoneForward *phoneForward) {
-	size_t i;
-	// Jeśli w danym wierzchołku istnieje przekierowanie, to je usuwamy
-	if (phoneForward->forwardTo != NULL) {
-		phoneForwardListRemove(phoneForward->forwardTo->revert, phoneForward);
-		phoneForward->forwardTo = NULL;
+void phoneForwardCleanAll(struct PhoneForward *phoneForward, uint32_t node,
+                          uint32_t forwardAncestor) {
+	unsigned i, count;
+	uint32_t const *children;
+	struct PhoneForwardNode *nodePtr, *childNode;
+
+	nodePtr = phoneForwardNode(phoneForward, node);
+	/*
+	 * Jeśli w danym wierzchołku istnieje przekierowanie, to je usuwamy, a oba
+	 * jego końce zaznaczamy do ewentualnego scalenia z synem.
+	 */
+	if (nodePtr->forwardTo != PHONE_FORWARD_NULL) {
+		phoneForwardListRemove(phoneForward, nodePtr->forwardTo, node);
+		phoneForwardMarkPending(phoneForward, nodePtr->forwardTo);
+		phoneForwardMarkPending(phoneForward, node);
+		nodePtr->forwardTo = PHONE_FORWARD_NULL;
 	}
+	nodePtr->forwardAncestor = forwardAncestor;
 
-	// Iterujemy się po synach i w nich też usuwamy przekierowania
-	for (i = 0; i < SIZE_OF_ALPHABET; i++)
-		if (phoneForward->nextLetter[i] != NULL)
-			phoneForwardCleanAll(phoneForward->nextLetter[i]);
+	/*
+	 * Iterujemy się po istniejących synach i w nich też usuwamy przekierowania.
+	 * W poddrzewie bez przekierowań wszystkie wierzchołki mają to samo pole
+	 * forwardAncestor, więc wystarczy sprawdzić je w synu.
+	 */
+	children = phoneForwardChildArray(phoneForward, nodePtr);
+	count = phoneForwardBitCount(nodePtr->childMask);
+	for (i = 0; i < count; i++) {
+		childNode = phoneForwardNode(phoneForward, children[i]);
+		if (childNode->forwardCount > 0 ||
+		    childNode->forwardAncestor != forwardAncestor)
+			phoneForwardCleanAll(phoneForward, children[i], forwardAncestor);
+	}
 }
 
 void phoneForwardRemove(struct PhoneForward *phoneForward, char const *number) {
-	struct PhoneForward *numberNode;
+	uint32_t numberNode, child;
+	struct PhoneForwardNode *childNode;
+	char const *rest;
 	// Sprawdzenie poprawności wejścia
 	if (phoneForward == NULL)
 		return;
 
-	// Znalezienie wierzchołka reprezentującego dany numer
-	numberNode = phoneForwardFromString(phoneForward, number);
+	/*
+	 * Znalezienie wierzchołka reprezentującego dany numer bez tworzenia nowych
+	 * wierzchołków - jeśli go nie ma, to nie ma też przekierowań do usunięcia.
+	 */
+	numberNode = phoneForwardFindLongestPrefix(phoneForward, number);
+	if (numberNode == PHONE_FORWARD_NULL)
+		return;
+	rest = number + phoneForwardNode(phoneForward, numberNode)->depth;
+
+	/*
+	 * Jeśli numer kończy się w środku krawędzi, to usuwamy przekierowania z
+	 * poddrzewa wierzchołka, do którego ta krawędź prowadzi.
+	 */
+	if (rest[0] != '\0') {
+		if (rest[0] < FIRST_LETTER || rest[0] > LAST_LETTER)
+			return;
+		child = phoneForwardChild(phoneForward,
+		                          phoneForwardNode(phoneForward, numberNode),
+		                          (unsigned) (rest[0] - FIRST_LETTER));
+		if (child == PHONE_FORWARD_NULL)
+			return;
+		childNode = phoneForwardNode(phoneForward, child);
+		if (strlen(rest) >= childNode->labelLength ||
+		    strncmp(rest, childNode->label, strlen(rest)) != 0)
+			return;
+		numberNode = child;
+	}
 
 	// Sprawdzenie poprawności numeru
-	if (numberNode == NULL || numberNode == phoneForward)
+	if (numberNode == PHONE_FORWARD_ROOT)
 		return;
 
-	// Wyczyszczenie przekierowań
-	phoneForwardCleanAll(numberNode);
-}
\ No newline at end of file
+	// Wyczyszczenie przekierowań i uproszczenie drzewa
+	phoneForward->version++;
+	phoneForwardCleanAll(
+			phoneForward, numberNode,
+			phoneForwardNode(
+					phoneForward,
+					phoneForwardNode(phoneForward, numberNode)->prev)
+					->forwardAncestor);
+	phoneForwardCollectPending(phoneForward);
+}
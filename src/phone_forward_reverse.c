@@ -7,130 +7,219 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include "phone_forward_reverse.h"
-#include "string_list.h"
 #include "phone_numbers.h"
 #include "phone_forward_struct.h"
 #include "phone_forward_list.h"
 
 /**
- * @brief Funkcja pomicnicza @ref phoneForwardReverse
- * Zapisuje numery szukane w @ref phoneForwardReverse reprezentowane przez słowa
- * do danej listy słów.
+ * @brief Liczy numery szukane w @ref phoneForwardReverse.
+ * Wyznacza liczbę kandydatów na numery szukane w @ref phoneForwardReverse
+ * (z powtórzeniami) i ich łączną długość.
  * @param phoneForward – wskaźnik na strukturę przechowującą przekierowania
  *                       numerów;
- * @param[in] mainList – wskaźnik listę do której zostaną dopisane słowa
- *                       reprezentujące szukane numery telefonów;
- * @param[out] mainList – wskaźnik listę do której zostały dopisane słowa
- *                        reprezentujące szukane numery telefonów;
- * @param begin – wskaźnik na wierzchołek drzewa reprezentujący napis pusty;
- * @param end – wkaźnik na wierzchołek drzewa z reprezentujący numer, z którego
- *              szukane są numery telefonów.
- * @return Wartość @c true, jeśli operacja się powiodła
- *         Wartość @c false, jeśli operacja się nie powiodła (np. nie udało się
- *         zaalokować pamięci).
+ * @param node – indeks wierzchołka drzewa reprezentującego najdłuższy
+ *               istniejący prefiks numeru;
+ * @param numberLength – długość numeru;
+ * @param[out] count – wskaźnik na zmienną, do której zostanie zapisana liczba
+ *                     kandydatów;
+ * @param[out] length – wskaźnik na zmienną, do której zostanie zapisana łączna
+ *                      długość kandydatów razem ze znakami @c '\0'.
  */
-bool phoneForwardReverseToList(struct PhoneForward *phoneForward,
-                               struct StringList *mainList,
-                               struct PhoneForward *begin,
-                               struct PhoneForward *end) {
-    struct PhoneForwardList *currentElem;
-    char const *currentNumber;
-
-    // Jeśli doszliśmy do pustego słowa, to dodajemy oryginalny numer do listy.
-    if (phoneForward->nodeChar == '\0') {
-        // Utworzenie słowa reprezentującego orginalny numer
-        currentNumber = phoneForwardToString(begin, begin, begin, end);
-        if (currentNumber == NULL)
-            return false;
-
-        // Dodanie tego słowa do listy
-        if (!stringListAdd(mainList, currentNumber)) {
-            free((void *) currentNumber);
-            return false;
+void phoneForwardReverseCount(struct PhoneForward *phoneForward, uint32_t node,
+                              size_t numberLength, size_t *count,
+                              size_t *length) {
+    struct PhoneForwardNode *nodePtr, *currentElem;
+    uint32_t currentIndex;
+    size_t suffixLength;
+
+    // Oryginalny numer zawsze jest wynikiem
+    *count = 1;
+    *length = numberLength + 1;
+
+    // Przejście po przodkach wierzchołka i ich odwrotnościach przekierowań
+    for (; node != PHONE_FORWARD_ROOT; node = nodePtr->prev) {
+        nodePtr = phoneForwardNode(phoneForward, node);
+        suffixLength = numberLength - (size_t) nodePtr->depth;
+        for (currentIndex = nodePtr->revert;
+             currentIndex != PHONE_FORWARD_NULL;
+             currentIndex = currentElem->revertNext) {
+            currentElem = phoneForwardNode(phoneForward, currentIndex);
+            (*count)++;
+            *length += (size_t) currentElem->depth + suffixLength + 1;
         }
-        return true;
     }
+}
 
-    /* Przeiterowanie się po możliwych odwrotnościach przekierowań z danego
-     * numeru.
-     */
-    currentElem = phoneForward->revert->next;
-    while (currentElem != NULL) {
-        /* Utworzenie słowa reprezentującego numer z którego przekierowywujemy,
-         * jeśli przekierowaniem jest za numeru reprezentowanego przez aktualny
-         * wierzchołek, na numer reprezentowany przez aktualny element listy.
+/**
+ * @brief Funkcja pomicnicza @ref phoneForwardReverse
+ * Zapisuje numery szukane w @ref phoneForwardReverse (z powtórzeniami, w
+ * dowolnej kolejności) jeden za drugim do bufora.
+ * @param phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                       numerów;
+ * @param node – indeks wierzchołka drzewa reprezentującego najdłuższy
+ *               istniejący prefiks numeru @p number;
+ * @param number – wskaźnik na słowo reprezentujące numer, z którego szukane są
+ *                 numery telefonów;
+ * @param numberLength – długość numeru @p number;
+ * @param[out] buffer – bufor na numery, rozmiaru wyznaczonego przez
+ *                      @ref phoneForwardReverseCount;
+ * @param[out] offsets – tablica na pozycje początków numerów w buforze,
+ *                       rozmiaru wyznaczonego przez
+ *                       @ref phoneForwardReverseCount.
+ */
+void phoneForwardReverseToBuffer(struct PhoneForward *phoneForward,
+                                 uint32_t node, char const *number,
+                                 size_t numberLength, char *buffer,
+                                 size_t *offsets) {
+    struct PhoneForwardNode *nodePtr, *currentElem;
+    uint32_t currentIndex;
+    size_t position, suffixLength;
+
+    // Zapisanie oryginalnego numeru
+    memcpy(buffer, number, numberLength + 1);
+    offsets[0] = 0;
+    offsets++;
+    position = numberLength + 1;
+
+    for (; node != PHONE_FORWARD_ROOT; node = nodePtr->prev) {
+        nodePtr = phoneForwardNode(phoneForward, node);
+        suffixLength = numberLength - (size_t) nodePtr->depth;
+
+        /*
+         * Zapisanie słów reprezentujących numery z których przekierowywujemy
+         * na numer reprezentowany przez aktualny wierzchołek, z dopisaną
+         * resztą numeru.
          */
-        currentNumber = phoneForwardToString(begin, currentElem->val,
-                                             phoneForward, end);
-        if (currentNumber == NULL)
-            return false;
-
-        // Dodanie tego słowa do listy
-        if (!stringListAdd(mainList, currentNumber)) {
-            free((void *) currentNumber);
-            return false;
+        for (currentIndex = nodePtr->revert;
+             currentIndex != PHONE_FORWARD_NULL;
+             currentIndex = currentElem->revertNext) {
+            currentElem = phoneForwardNode(phoneForward, currentIndex);
+            *offsets++ = position;
+            phoneForwardWriteString(phoneForward, currentIndex,
+                                    buffer + position);
+            position += (size_t) currentElem->depth;
+            memcpy(buffer + position, number + nodePtr->depth,
+                   suffixLength + 1);
+            position += suffixLength + 1;
         }
-        currentElem = currentElem->next;
     }
+}
+
+/**
+ * @brief Znajduje wierzchołek numeru.
+ * Pomocnicza do @ref phoneForwardReverse i @ref phoneForwardReverseInto.
+ * Sprawdza poprawność numeru i znajduje najgłębszy istniejący wierzchołek
+ * reprezentujący jego prefiks bez tworzenia nowych wierzchołków w drzewie.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param number – wskaźnik na napis;
+ * @param[out] length – wskaźnik na zmienną, do której zostanie zapisana
+ *                      długość numeru.
+ * @return Indeks znalezionego wierzchołka, lub @ref PHONE_FORWARD_NULL, jeśli
+ *         napis @p number nie reprezentuje numeru.
+ */
+uint32_t phoneForwardReverseFind(struct PhoneForward *phoneForward,
+                                 char const *number, size_t *length) {
+    size_t i;
+
+    // Sprawdzenie czy dany numer może reprezentować numer
+    if (number == NULL)
+        return PHONE_FORWARD_NULL;
+    for (i = 0; number[i] != '\0'; i++)
+        if (number[i] < FIRST_LETTER || number[i] > LAST_LETTER)
+            return PHONE_FORWARD_NULL;
+
+    // Sprawdzenie, czy dany numer nie jest pusty
+    if (i == 0)
+        return PHONE_FORWARD_NULL;
 
-    // Wywołanie tej samej procedury dla przekierowań w poprzednim wierzchołku
-    return phoneForwardReverseToList(phoneForward->prev, mainList, begin, end);
+    *length = i;
+    return phoneForwardFindLongestPrefix(phoneForward, number);
 }
 
 struct PhoneNumbers const *phoneForwardReverse(struct PhoneForward *phoneForward,
                                                char const *number) {
-    struct StringList *stringList;
-    struct PhoneForward *numberNode;
-    char const *const *outList;
-    size_t size, i;
+    struct PhoneNumbers *result;
+    uint32_t numberNode;
+    char *buffer;
+    size_t *offsets;
+    size_t count, length, numberLength;
 
     // Sprawdzenie poprawności wejścia
     if (phoneForward == NULL)
         return NULL;
-    i = 0;
-
-    // Sprawdzenie czy dany numer może reprezentować numer
-    if (number == NULL)
+    numberNode = phoneForwardReverseFind(phoneForward, number, &numberLength);
+    if (numberNode == PHONE_FORWARD_NULL)
         return phoneNumbersCreateEmpty();
-    while (number[i] != '\0') {
-        if (number[i] < FIRST_LETTER || number[i] > LAST_LETTER)
-            return phoneNumbersCreateEmpty();
-        i++;
-    }
 
-    // Znalezienie wierzchołka reprezentującego dany numer
-    numberNode = phoneForwardFromString(phoneForward, number);
-    if (numberNode == NULL)
+    // Zaalokowanie jednego bufora na wszystkich kandydatów
+    phoneForwardReverseCount(phoneForward, numberNode, numberLength, &count,
+                             &length);
+    buffer = malloc(length);
+    offsets = malloc(count * sizeof(size_t));
+    if (buffer == NULL || offsets == NULL) {
+        free(buffer);
+        free(offsets);
         return NULL;
+    }
 
-    // Sprawdzenie, czy dany numer nie jest pusty
-    if (numberNode == phoneForward)
-        return phoneNumbersCreateEmpty();
+    // Zapisanie kandydatów i utworzenie z nich posortowanego ciągu
+    phoneForwardReverseToBuffer(phoneForward, numberNode, number, numberLength,
+                                buffer, offsets);
+    result = phoneNumbersCreateSorted(buffer, offsets, count);
 
-    // Utworzenie listy na wynikowe słowa
-    stringList = stringListCreate();
-    if (stringList == NULL)
-        return NULL;
+    free(buffer);
+    free(offsets);
+    return result;
+}
 
-    //
-    if (!phoneForwardReverseToList(numberNode, stringList, phoneForward,
-                                   numberNode)) {
-        stringListDestroy(stringList);
-        return NULL;
-    }
+size_t phoneForwardReverseInto(struct PhoneForward *phoneForward,
+                               char const *number, char *buffer,
+                               size_t capacity, size_t *resultCount) {
+    uint32_t numberNode;
+    char *candidates, *output;
+    size_t *offsets;
+    size_t count, length, numberLength, required, i, currentLength;
+    uintptr_t misalignment;
 
-    // Zapisanie liczby wynikowych słów
-    size = stringListSize(stringList);
+    *resultCount = 0;
 
-    // Zamienienie listy słów na tablicę
-    outList = stringListToStringsAndDestroy(stringList);
-    if (outList == NULL) {
-        stringListDestroy(stringList);
-        return NULL;
+    // Sprawdzenie poprawności wejścia
+    if (phoneForward == NULL)
+        return 0;
+    numberNode = phoneForwardReverseFind(phoneForward, number, &numberLength);
+    if (numberNode == PHONE_FORWARD_NULL)
+        return 0;
+
+    /*
+     * Obszar roboczy składa się z miejsca na wynik, miejsca na kandydatów i,
+     * po wyrównaniu, tablic pozycji kandydatów i pomocniczej do sortowania.
+     */
+    phoneForwardReverseCount(phoneForward, numberNode, numberLength, &count,
+                             &length);
+    required = 2 * length + sizeof(size_t) - 1 + 2 * count * sizeof(size_t);
+    if (required > capacity || buffer == NULL)
+        return required;
+    candidates = buffer + length;
+    misalignment = (uintptr_t) (candidates + length) % sizeof(size_t);
+    offsets = (size_t *) (candidates + length +
+                          (misalignment ? sizeof(size_t) - misalignment : 0));
+
+    // Zapisanie i posortowanie kandydatów
+    phoneForwardReverseToBuffer(phoneForward, numberNode, number, numberLength,
+                                candidates, offsets);
+    count = phoneNumbersSortUnique(candidates, offsets, offsets + count, count);
+
+    // Przepisanie wyników na początek bufora
+    output = buffer;
+    for (i = 0; i < count; i++) {
+        currentLength = strlen(candidates + offsets[i]) + 1;
+        memcpy(output, candidates + offsets[i], currentLength);
+        output += currentLength;
     }
-
-    // Utworzenie struktury PhoneNumbers i jej zwrócenie
-    return phoneNumbersCreate(outList, size);
-}
\ No newline at end of file
+    *resultCount = count;
+    return required;
+}
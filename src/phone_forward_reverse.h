@@ -30,4 +30,29 @@
 struct PhoneNumbers const *phoneForwardReverse(struct PhoneForward *phoneForward,
                                                char const *number);
 
+/** @brief Wyznacza przekierowania na dany numer do bufora.
+ * Działa jak @ref phfwdReverseInto.
+ * Wyznacza przekierowania na podany numer tak jak @ref phoneForwardReverse,
+ * ale zapisuje je jeden za drugim jako napisy zakończone znakiem @c '\0' na
+ * początek obszaru roboczego @p buffer podanego przez wywołującego, bez
+ * alokowania pamięci. Obszar roboczy musi pomieścić też kandydatów przed
+ * posortowaniem i usunięciem powtórzeń, więc jest większy od samego wyniku.
+ * Jeśli obszar jest za mały, nie jest zmieniany.
+ * @param[in] phoneForward – wskaźnik na strukturę przechowującą przekierowania
+ *                           numerów;
+ * @param[in] number – wskaźnik na napis reprezentujący numer;
+ * @param[out] buffer – wskaźnik na obszar roboczy;
+ * @param capacity – rozmiar obszaru @p buffer;
+ * @param[out] resultCount – wskaźnik na zmienną, do której zostanie zapisana
+ *                           liczba zapisanych numerów (@c 0, jeśli wynik nie
+ *                           został zapisany).
+ * @return Wymagany rozmiar obszaru roboczego, lub wartość @c 0, jeśli
+ *         wynikiem jest pusty ciąg (np. podany napis nie reprezentuje
+ *         numeru). Wynik został zapisany wtedy i tylko wtedy, gdy zwrócona
+ *         wartość jest dodatnia i nie większa niż @p capacity.
+ */
+size_t phoneForwardReverseInto(struct PhoneForward *phoneForward,
+                               char const *number, char *buffer,
+                               size_t capacity, size_t *resultCount);
+
 #endif //TEL_PHONE_FORWARD_REVERSE_H
@@ -7,140 +7,552 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "slab_arena.h"
 #include "phone_forward_struct.h"
+#include "phone_forward_list.h"
 
-// Deklaracja tej funkcji znajduje się w pliku "phone_forward_list.c"
-struct PhoneForwardList *phoneForwardListCreate(void);
-
-// Deklaracja tej funkcji znajduje się w pliku "phone_forward_list.c"
-void phoneForwardListDestroy(struct PhoneForwardList *phoneForwardList);
+/**
+ * Początkowy rozmiar tablicy wierzchołków do sprawdzenia
+ */
+#define PENDING_INITIAL_CAPACITY 16
 
 /**
  * @brief Tworzy wierchołek drzewa.
- * Tworzy wierchołek drzewa z podanym znakiem @p nodeChar, głębokością @p depth
- * i ojcem @p prev.
- * @param nodeChar – znak, który zostanie znakiem tego wierzchołka;
- * @param depth – głębokość, którą będzie miał zapisany ten wierzchołek;
- * @param prev – wskaźnik na ojca, który będzie miał zapisany ten wierchołek.
- * @return Wskaźnik na utworzoną strukturę lub @c NULL, gdy nie udało się
- *         zaalokować pamięci.
+ * Tworzy w arenie bazy @p phoneForward wierchołek drzewa z podaną etykietą
+ * krawędzi @p label długości @p labelLength i ojcem @p prev.
+ * @param phoneForward – wskaźnik na bazę, z której areny jest przydzielany
+ *                       wierzchołek;
+ * @param label – wskaźnik na etykietę krawędzi do tego wierzchołka;
+ * @param labelLength – długość etykiety, co najwyżej
+ *                      @ref PHONE_FORWARD_LABEL_CAPACITY;
+ * @param prev – indeks ojca, który będzie miał zapisany ten wierchołek, lub
+ *               @ref PHONE_FORWARD_NULL dla korzenia.
+ * @return Indeks utworzonego wierzchołka lub @ref PHONE_FORWARD_NULL, gdy nie
+ *         udało się zaalokować pamięci.
  */
-struct PhoneForward *phoneForwardCreateNode(char nodeChar, int depth,
-                                            struct PhoneForward *prev) {
-    size_t i;
-    struct PhoneForward *newPhoneForward;
+uint32_t phoneForwardCreateNode(struct PhoneForward *phoneForward,
+                                char const *label, size_t labelLength,
+                                uint32_t prev) {
+    uint32_t newIndex;
+    struct PhoneForwardNode *newNode;
 
-    // Zaalkowanie nowej struktury.
-    newPhoneForward = malloc(sizeof(struct PhoneForward));
-    if (newPhoneForward == NULL)
-        return NULL;
+    /*
+     * Przydzielenie nowego wierzchołka z areny - jest on już wyzerowany, więc
+     * ma pustą listę odwrotności, która zajmie pamięć dopiero, gdy wierzchołek
+     * stanie się celem przekierowania.
+     */
+    newIndex = slabArenaAlloc(&phoneForward->nodes);
+    if (newIndex == PHONE_FORWARD_NULL)
+        return PHONE_FORWARD_NULL;
 
-    // Utworzenie listy zawartej w tej strukturze
-    newPhoneForward->revert = phoneForwardListCreate();
-    if (newPhoneForward->revert == NULL) {
-        free(newPhoneForward);
-        return NULL;
+    // Ustawienie parametrów
+    newNode = phoneForwardNode(phoneForward, newIndex);
+    if (prev != PHONE_FORWARD_NULL)
+        newNode->depth = phoneForwardNode(phoneForward, prev)->depth +
+                         (int) labelLength;
+    newNode->prev = prev;
+    if (prev != PHONE_FORWARD_NULL)
+        newNode->forwardAncestor =
+                phoneForwardNode(phoneForward, prev)->forwardAncestor;
+    newNode->labelLength = (uint8_t) labelLength;
+    memcpy(newNode->label, label, labelLength);
+
+    // Zwrócenie nowego wierzchołka
+    return newIndex;
+}
+
+/**
+ * @brief Zwalnia wierzchołek drzewa.
+ * Oddaje do areny bazy wierzchołek @p node. Wierzchołek nie może być już
+ * podpięty do drzewa ani mieć przekierowań. Zwolniony wierzchołek ma ojca
+ * @ref PHONE_FORWARD_NULL, co pozwala go odróżnić od wierzchołków w drzewie
+ * do czasu kolejnego przydzielenia.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks zwalnianego wierzchołka.
+ */
+void phoneForwardDestroyNode(struct PhoneForward *phoneForward, uint32_t node) {
+    struct PhoneForwardNode *nodePtr;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    nodePtr->prev = PHONE_FORWARD_NULL;
+    slabArenaFree(&phoneForward->nodes, node);
+}
+
+bool phoneForwardAddChild(struct PhoneForward *phoneForward, uint32_t node,
+                          unsigned letter, uint32_t child) {
+    struct PhoneForwardNode *nodePtr;
+    uint32_t *oldArray, *newArray;
+    uint32_t newChildren;
+    unsigned count, position, i;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    count = phoneForwardBitCount(nodePtr->childMask);
+
+    // Pierwszy syn jest zapisywany bezpośrednio w wierzchołku
+    if (count == 0) {
+        nodePtr->children = child;
+        nodePtr->childMask = (uint16_t) (1u << letter);
+        return true;
     }
 
-    // Ustawienie parametrów
-    newPhoneForward->depth = depth;
-    newPhoneForward->nodeChar = nodeChar;
-    newPhoneForward->prev = prev;
-    newPhoneForward->forwardTo = NULL;
-    for (i = 0; i < SIZE_OF_ALPHABET; i++) {
-        newPhoneForward->nextLetter[i] = NULL;
+    // Przydzielenie tablicy o jeden dłuższej
+    newChildren = slabArenaAlloc(&phoneForward->childArrays[count + 1]);
+    if (newChildren == PHONE_FORWARD_NULL)
+        return false;
+    oldArray = phoneForwardChildArray(phoneForward, nodePtr);
+    newArray = slabArenaGet(&phoneForward->childArrays[count + 1],
+                            newChildren);
+
+    // Przepisanie synów z wstawieniem nowego na jego miejsce
+    position = phoneForwardBitCount(nodePtr->childMask & ((1u << letter) - 1));
+    for (i = 0; i < position; i++)
+        newArray[i] = oldArray[i];
+    newArray[position] = child;
+    for (i = position; i < count; i++)
+        newArray[i + 1] = oldArray[i];
+
+    // Zwolnienie starej tablicy i podpięcie nowej
+    if (count > 1)
+        slabArenaFree(&phoneForward->childArrays[count], nodePtr->children);
+    nodePtr->children = newChildren;
+    nodePtr->childMask |= (uint16_t) (1u << letter);
+    return true;
+}
+
+/**
+ * @brief Podmienia syna wierzchołka.
+ * Zastępuje istniejącego syna wierzchołka @p node dla znaku @p letter
+ * wierzchołkiem @p child. Nie alokuje pamięci.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks wierzchołka;
+ * @param letter – numer pierwszego znaku etykiety syna;
+ * @param child – indeks nowego syna.
+ */
+void phoneForwardReplaceChild(struct PhoneForward *phoneForward, uint32_t node,
+                              unsigned letter, uint32_t child) {
+    struct PhoneForwardNode *nodePtr;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    phoneForwardChildArray(phoneForward, nodePtr)[phoneForwardBitCount(
+            nodePtr->childMask & ((1u << letter) - 1))] = child;
+}
+
+/**
+ * @brief Dzieli krawędź.
+ * Wstawia nowy wierzchołek w krawędź prowadzącą do wierzchołka @p child po
+ * pierwszych @p length znakach jej etykiety.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param child – indeks wierzchołka, do którego prowadzi dzielona krawędź;
+ * @param length – liczba znaków etykiety przed nowym wierzchołkiem, większa
+ *                 od @c 0 i mniejsza od długości etykiety.
+ * @return Indeks nowego wierzchołka lub @ref PHONE_FORWARD_NULL, gdy nie
+ *         udało się zaalokować pamięci (drzewo pozostaje wtedy niezmienione).
+ */
+uint32_t phoneForwardSplitEdge(struct PhoneForward *phoneForward,
+                               uint32_t child, size_t length) {
+    struct PhoneForwardNode *childNode, *middleNode;
+    uint32_t middle, prev;
+
+    childNode = phoneForwardNode(phoneForward, child);
+    prev = childNode->prev;
+
+    // Utworzenie wierzchołka z początkiem etykiety
+    middle = phoneForwardCreateNode(phoneForward, childNode->label, length,
+                                    prev);
+    if (middle == PHONE_FORWARD_NULL)
+        return PHONE_FORWARD_NULL;
+    middleNode = phoneForwardNode(phoneForward, middle);
+
+    // Podpięcie nowego wierzchołka w miejsce dzielonej krawędzi
+    phoneForwardReplaceChild(phoneForward, prev,
+                             (unsigned) (childNode->label[0] - FIRST_LETTER),
+                             middle);
+
+    // Skrócenie etykiety wierzchołka do jej końca
+    childNode->labelLength = (uint8_t) (childNode->labelLength - length);
+    memmove(childNode->label, childNode->label + length,
+            childNode->labelLength);
+    childNode->prev = middle;
+
+    // Jedynym synem nowego wierzchołka jest skrócony wierzchołek
+    middleNode->forwardCount = childNode->forwardCount;
+    middleNode->revertCount = childNode->revertCount;
+    middleNode->children = child;
+    middleNode->childMask =
+            (uint16_t) (1u << (childNode->label[0] - FIRST_LETTER));
+
+    return middle;
+}
+
+/**
+ * @brief Usuwa syna wierzchołka.
+ * Odpina syna wierzchołka @p node dla znaku @p letter.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks wierzchołka;
+ * @param letter – numer pierwszego znaku etykiety istniejącego syna.
+ * @return Wartość @c true, jeśli usuwanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować krótszej tablicy synów
+ *         (drzewo pozostaje wtedy niezmienione).
+ */
+bool phoneForwardRemoveChild(struct PhoneForward *phoneForward, uint32_t node,
+                             unsigned letter) {
+    struct PhoneForwardNode *nodePtr;
+    uint32_t *oldArray, *newArray;
+    uint32_t newChildren;
+    unsigned count, position, i;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    count = phoneForwardBitCount(nodePtr->childMask);
+    position = phoneForwardBitCount(nodePtr->childMask & ((1u << letter) - 1));
+    oldArray = phoneForwardChildArray(phoneForward, nodePtr);
+
+    if (count == 1) {
+        // Usunięcie jedynego syna
+        newChildren = PHONE_FORWARD_NULL;
+    } else if (count == 2) {
+        // Pozostały syn jest zapisywany bezpośrednio w wierzchołku
+        newChildren = oldArray[1 - position];
+    } else {
+        // Przepisanie synów do tablicy o jeden krótszej
+        newChildren = slabArenaAlloc(&phoneForward->childArrays[count - 1]);
+        if (newChildren == PHONE_FORWARD_NULL)
+            return false;
+        newArray = slabArenaGet(&phoneForward->childArrays[count - 1],
+                                newChildren);
+        for (i = 0; i < position; i++)
+            newArray[i] = oldArray[i];
+        for (i = position + 1; i < count; i++)
+            newArray[i - 1] = oldArray[i];
     }
 
-    // Zwrócenie nowej struktury
-    return newPhoneForward;
+    // Zwolnienie starej tablicy i podpięcie nowej
+    if (count > 1)
+        slabArenaFree(&phoneForward->childArrays[count], nodePtr->children);
+    nodePtr->children = newChildren;
+    nodePtr->childMask &= (uint16_t) ~(1u << letter);
+    return true;
+}
+
+/**
+ * @brief Usuwa niepotrzebne wierzchołki.
+ * Wierzchołek jest niepotrzebny, jeśli nie jest korzeniem i nie ma
+ * przekierowania ani jego odwrotności. Niepotrzebny liść jest usuwany, po
+ * czym to samo sprawdzenie jest powtarzane dla jego ojca. Niepotrzebny
+ * wierzchołek z jednym synem jest z nim scalany w jedną krawędź, o ile
+ * łączna długość etykiet się mieści.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks pierwszego sprawdzanego wierzchołka.
+ */
+void phoneForwardCollectNode(struct PhoneForward *phoneForward,
+                             uint32_t node) {
+    struct PhoneForwardNode *nodePtr, *childNode;
+    uint32_t child, prev;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    // Sprawdzenie, czy wierzchołek jest jeszcze w drzewie
+    if (nodePtr->prev == PHONE_FORWARD_NULL)
+        return;
+
+    while (node != PHONE_FORWARD_ROOT &&
+           nodePtr->forwardTo == PHONE_FORWARD_NULL &&
+           phoneForwardListIsEmpty(nodePtr->revert)) {
+        prev = nodePtr->prev;
+
+        if (nodePtr->childMask == 0) {
+            // Odpięcie liścia od ojca i jego zwolnienie
+            if (!phoneForwardRemoveChild(
+                    phoneForward, prev,
+                    (unsigned) (nodePtr->label[0] - FIRST_LETTER)))
+                return;
+            phoneForwardDestroyNode(phoneForward, node);
+
+            // Ojciec mógł właśnie przestać być potrzebny
+            node = prev;
+            nodePtr = phoneForwardNode(phoneForward, node);
+            continue;
+        }
+
+        // Wierzchołek z co najmniej dwoma synami jest rozgałęzieniem
+        if (phoneForwardBitCount(nodePtr->childMask) != 1)
+            return;
+        child = nodePtr->children;
+        childNode = phoneForwardNode(phoneForward, child);
+        if (nodePtr->labelLength + childNode->labelLength >
+            PHONE_FORWARD_LABEL_CAPACITY)
+            return;
+
+        // Dopisanie etykiety wierzchołka na początek etykiety syna
+        memmove(childNode->label + nodePtr->labelLength, childNode->label,
+                childNode->labelLength);
+        memcpy(childNode->label, nodePtr->label, nodePtr->labelLength);
+        childNode->labelLength =
+                (uint8_t) (childNode->labelLength + nodePtr->labelLength);
+
+        // Podpięcie syna w miejsce wierzchołka i zwolnienie wierzchołka
+        childNode->prev = prev;
+        phoneForwardReplaceChild(phoneForward, prev,
+                                 (unsigned) (nodePtr->label[0] - FIRST_LETTER),
+                                 child);
+        phoneForwardDestroyNode(phoneForward, node);
+        return;
+    }
+}
+
+void phoneForwardSetForwardAncestor(struct PhoneForward *phoneForward,
+                                    uint32_t node, uint32_t from,
+                                    uint32_t to) {
+    struct PhoneForwardNode *nodePtr;
+    uint32_t const *children;
+    unsigned i, count;
+
+    nodePtr = phoneForwardNode(phoneForward, node);
+    if (nodePtr->forwardAncestor != from)
+        return;
+    nodePtr->forwardAncestor = to;
+
+    // Przejście do synów
+    children = phoneForwardChildArray(phoneForward, nodePtr);
+    count = phoneForwardBitCount(nodePtr->childMask);
+    for (i = 0; i < count; i++)
+        phoneForwardSetForwardAncestor(phoneForward, children[i], from, to);
+}
+
+void phoneForwardMarkPending(struct PhoneForward *phoneForward,
+                             uint32_t node) {
+    uint32_t *newPending;
+    size_t newCapacity;
+
+    /*
+     * Brak wierzchołka (na przykład dla niepoprawnego numeru) nie jest
+     * sprawdzany - miejsce zerowe areny nie jest wierzchołkiem.
+     */
+    if (node == PHONE_FORWARD_NULL)
+        return;
+
+    // Powiększenie tablicy dwukrotnie, jeśli zajdzie taka potrzeba
+    if (phoneForward->pendingCount == phoneForward->pendingCapacity) {
+        newCapacity = phoneForward->pendingCapacity == 0
+                      ? PENDING_INITIAL_CAPACITY
+                      : 2 * phoneForward->pendingCapacity;
+        newPending = realloc(phoneForward->pending,
+                             newCapacity * sizeof(uint32_t));
+        if (newPending == NULL)
+            return;
+        phoneForward->pending = newPending;
+        phoneForward->pendingCapacity = newCapacity;
+    }
+
+    phoneForward->pending[phoneForward->pendingCount++] = node;
+}
+
+void phoneForwardCollectPending(struct PhoneForward *phoneForward) {
+    // Zwalniane wierzchołki nie są ponownie przydzielane w czasie sprawdzania
+    while (phoneForward->pendingCount > 0)
+        phoneForwardCollectNode(
+                phoneForward,
+                phoneForward->pending[--phoneForward->pendingCount]);
 }
 
 struct PhoneForward *phoneForwardCreate(void) {
+    struct PhoneForward *newPhoneForward;
+    size_t i;
+
+    // Zaalkowanie nowej struktury
+    newPhoneForward = malloc(sizeof(struct PhoneForward));
+    if (newPhoneForward == NULL)
+        return NULL;
+
+    // Przygotowanie pustych aren
+    slabArenaInit(&newPhoneForward->nodes, sizeof(struct PhoneForwardNode));
+    for (i = 0; i <= SIZE_OF_ALPHABET; i++)
+        slabArenaInit(&newPhoneForward->childArrays[i],
+                      (i > 0 ? i : 1) * sizeof(uint32_t));
+    newPhoneForward->pending = NULL;
+    newPhoneForward->pendingCount = 0;
+    newPhoneForward->pendingCapacity = 0;
+    newPhoneForward->nonTrivial = NULL;
+    newPhoneForward->nonTrivialCapacity = 0;
+    newPhoneForward->nonTrivialUsed = 0;
+    newPhoneForward->nonTrivialMaxDepth = 0;
+    newPhoneForward->nonTrivialStale = false;
+    newPhoneForward->nonTrivialWalkVersion = 0;
+    newPhoneForward->version = 1;
+    for (i = 0; i < NON_TRIVIAL_CACHE_SIZE; i++)
+        newPhoneForward->nonTrivialCache[i].version = 0;
+
     // Pusta struktura, to reprezentujący drzewo korzeń.
-    return phoneForwardCreateNode('\0', 0, NULL);
+    if (phoneForwardCreateNode(newPhoneForward, "", 0, PHONE_FORWARD_NULL)
+        != PHONE_FORWARD_ROOT) {
+        phoneForwardDestroy(newPhoneForward);
+        return NULL;
+    }
+
+    return newPhoneForward;
 }
 
 void phoneForwardDestroy(struct PhoneForward *phoneForward) {
     size_t i;
+
     // Sprawdzenie poprawności danych wejściowych
     if (phoneForward == NULL)
         return;
 
-    // Zniszczenie synów wierzchołka
-    for (i = 0; i < SIZE_OF_ALPHABET; i++) {
-        phoneForwardDestroy(phoneForward->nextLetter[i]);
-    }
-
-    // Zniszczenie listy przechowywanej przez wierchołek i danego wierzchołka
-    phoneForwardListDestroy(phoneForward->revert);
+    /*
+     * Wszystkie wierzchołki i tablice synów są w arenach bazy, więc wystarczy
+     * zwolnić ich bloki.
+     */
+    slabArenaDestroy(&phoneForward->nodes);
+    for (i = 0; i <= SIZE_OF_ALPHABET; i++)
+        slabArenaDestroy(&phoneForward->childArrays[i]);
+    free(phoneForward->pending);
+    free(phoneForward->nonTrivial);
     free((void *) phoneForward);
 }
 
-struct PhoneForward *phoneForwardFromString(struct PhoneForward *phoneForward,
-                                            char const *num) {
+uint32_t phoneForwardFromString(struct PhoneForward *phoneForward,
+                                char const *num) {
     // Sprawdzenie poprawności danych wejściowcyh
-    if (num == NULL) {
-        return NULL;
-    } // Sprawdzenie, czy doszliśmy do końca słowa
-    else if (num[0] == '\0') {
-
-        return phoneForward;
-
-    } // Sprawdzenie, czy aktualnie rozpatrywana litera jest dozwolona
-    else if (num[0] >= FIRST_LETTER && num[0] <= LAST_LETTER) {
-        /*
-         * Sprawdzenie, czy istnieje kolejny porzebny wierzchołek i utworzenie
-         * go jeśli nie istnieje.
-         */
-        if (phoneForward->nextLetter[num[0] - FIRST_LETTER] == NULL) {
-            phoneForward->nextLetter[num[0] - FIRST_LETTER] =
-                    phoneForwardCreateNode(num[0], phoneForward->depth + 1,
-                                           phoneForward);
-            if (phoneForward->nextLetter[num[0] - FIRST_LETTER] == NULL)
-                return NULL;
+    if (num == NULL)
+        return PHONE_FORWARD_NULL;
+
+    return phoneForwardFromStringLength(phoneForward, num, strlen(num));
+}
+
+uint32_t phoneForwardFromStringLength(struct PhoneForward *phoneForward,
+                                      char const *num, size_t numLength) {
+    uint32_t current, next;
+    struct PhoneForwardNode *nextNode;
+    size_t i, length, remaining;
+    unsigned letter;
+
+    // Sprawdzenie poprawności danych wejściowcyh
+    if (num == NULL)
+        return PHONE_FORWARD_NULL;
+
+    // Sprawdzenie, czy wszystkie litery są dozwolone, przed zmianą drzewa
+    for (remaining = 0; remaining < numLength; remaining++)
+        if (num[remaining] < FIRST_LETTER || num[remaining] > LAST_LETTER)
+            return PHONE_FORWARD_NULL;
+
+    current = PHONE_FORWARD_ROOT;
+    // Przechodzenie kolejnych krawędzi aż do końca słowa
+    while (remaining > 0) {
+        letter = (unsigned) (num[0] - FIRST_LETTER);
+        next = phoneForwardChild(phoneForward,
+                                 phoneForwardNode(phoneForward, current),
+                                 letter);
+
+        // Jeśli nie ma krawędzi, to tworzymy nową z resztą słowa
+        if (next == PHONE_FORWARD_NULL) {
+            length = remaining < PHONE_FORWARD_LABEL_CAPACITY
+                     ? remaining : PHONE_FORWARD_LABEL_CAPACITY;
+            next = phoneForwardCreateNode(phoneForward, num, length, current);
+            if (next == PHONE_FORWARD_NULL) {
+                phoneForwardCollectNode(phoneForward, current);
+                return PHONE_FORWARD_NULL;
+            }
+            if (!phoneForwardAddChild(phoneForward, current, letter, next)) {
+                // Zwolnienie niepodpiętego wierzchołka
+                phoneForwardDestroyNode(phoneForward, next);
+                phoneForwardCollectNode(phoneForward, current);
+                return PHONE_FORWARD_NULL;
+            }
+            current = next;
+            num += length;
+            remaining -= length;
+            continue;
         }
+
+        // Znalezienie wspólnego początku słowa i etykiety krawędzi
+        nextNode = phoneForwardNode(phoneForward, next);
+        for (i = 1; i < nextNode->labelLength && i < remaining &&
+                    num[i] == nextNode->label[i];
+             i++);
+
+        // Jeśli słowo rozchodzi się z etykietą, to dzielimy krawędź
+        if (i < nextNode->labelLength) {
+            next = phoneForwardSplitEdge(phoneForward, next, i);
+            if (next == PHONE_FORWARD_NULL)
+                return PHONE_FORWARD_NULL;
+        }
+
         //Przejście dalej w słowie
-        return phoneForwardFromString(
-                phoneForward->nextLetter[num[0] - FIRST_LETTER], num + 1);
-    } else {
-        // Przypadek niepoprawnego znaku w słowie
-        return NULL;
+        current = next;
+        num += i;
+        remaining -= i;
+    }
+
+    return current;
+}
+
+uint32_t phoneForwardFindLongestPrefix(struct PhoneForward *phoneForward,
+                                       char const *number) {
+    uint32_t current, next;
+    struct PhoneForwardNode *nextNode;
+
+    // Sprawdzenie poprawności danych wejściowych
+    if (phoneForward == NULL || number == NULL)
+        return PHONE_FORWARD_NULL;
+
+    // Schodzenie w dół drzewa tak długo, jak istnieją kolejne wierzchołki
+    current = PHONE_FORWARD_ROOT;
+    while (number[0] >= FIRST_LETTER && number[0] <= LAST_LETTER &&
+           (next = phoneForwardChild(
+                   phoneForward, phoneForwardNode(phoneForward, current),
+                   (unsigned) (number[0] - FIRST_LETTER))) !=
+           PHONE_FORWARD_NULL) {
+        // Cała etykieta krawędzi musi być początkiem reszty słowa
+        nextNode = phoneForwardNode(phoneForward, next);
+        if (strncmp(number, nextNode->label, nextNode->labelLength) != 0)
+            break;
+        current = next;
+        number += nextNode->labelLength;
     }
+
+    return current;
 }
 
-char *phoneForwardToString(struct PhoneForward *begin1,
-                           struct PhoneForward *end1,
-                           struct PhoneForward *begin2,
-                           struct PhoneForward *end2) {
+void phoneForwardWriteString(struct PhoneForward *phoneForward, uint32_t end,
+                             char *destination) {
+    struct PhoneForwardNode *endNode;
+    size_t size;
+
+    // Zapisanie słowa od końca po jednej etykiecie krawędzi
+    endNode = phoneForwardNode(phoneForward, end);
+    size = (size_t) endNode->depth;
+    while (size) {
+        size -= endNode->labelLength;
+        memcpy(destination + size, endNode->label, endNode->labelLength);
+        endNode = phoneForwardNode(phoneForward, endNode->prev);
+    }
+}
+
+char *phoneForwardToString(struct PhoneForward *phoneForward, uint32_t end,
+                           char const *suffix) {
     size_t size1, size2;
     char *outString;
+    struct PhoneForwardNode *endNode;
 
-    // Sprawdzenie, czy słowa mają nieujemne długości
-    if (end1->depth - begin1->depth < 0 || end2->depth - begin2->depth < 0)
+    // Sprawdzenie, czy słowo ma nieujemną długość
+    endNode = phoneForwardNode(phoneForward, end);
+    if (endNode->depth < 0)
         return NULL;
 
     // Ustawienie długości słów
-    size1 = (size_t) (end1->depth - begin1->depth);
-    size2 = (size_t) (end2->depth - begin2->depth);
+    size1 = (size_t) endNode->depth;
+    size2 = strlen(suffix);
 
     // Zaalokowanie miejsca na wyjściowe słowo
     outString = malloc((size1 + size2 + 1) * sizeof(char));
     if (outString == NULL)
         return NULL;
 
-    // Ustawienie ostatniejgo znaku słowa
-    outString[size1 + size2] = '\0';
-
-    // Zapisanie drugiej części słowa
-    while (size2) {
-        outString[--size2 + size1] = end2->nodeChar;
-        end2 = end2->prev;
-    }
+    // Zapisanie drugiej części słowa razem z jego końcem
+    memcpy(outString + size1, suffix, (size2 + 1) * sizeof(char));
 
     // Zapisanie pierwszej części słowa
-    while (size1) {
-        outString[--size1] = end1->nodeChar;
-        end1 = end1->prev;
-    }
+    phoneForwardWriteString(phoneForward, end, outString);
     return outString;
-}
\ No newline at end of file
+}
@@ -9,6 +9,10 @@
 #ifndef TEL_PHONE_FORWARD_BASIC_H
 #define TEL_PHONE_FORWARD_BASIC_H
 
+#include <stdbool.h>
+#include <stdint.h>
+#include "slab_arena.h"
+
 /**
  * Pierwsza (alfabetycznie) dozwolona listera w słowie
  */
@@ -24,55 +28,411 @@
  */
 #define SIZE_OF_ALPHABET (LAST_LETTER - FIRST_LETTER + 1)
 
-struct PhoneForwardList;
+/**
+ * Maksymalna długość etykiety krawędzi prowadzącej do wierzchołka. Dłuższe
+ * nierozgałęzione ciągi znaków są dzielone na kilka wierzchołków. Wartość
+ * dobrana tak, by etykieta wypełniała wierzchołek do 56 bajtów (dziesięć pól
+ * czterobajtowych, maska synów i długość etykiety) bez dopełnienia.
+ */
+#define PHONE_FORWARD_LABEL_CAPACITY 13
+
+/**
+ * Indeks oznaczający brak wierzchołka
+ */
+#define PHONE_FORWARD_NULL SLAB_ARENA_NULL
+
+/**
+ * Indeks korzenia drzewa - pierwszego wierzchołka przydzielonego z areny
+ */
+#define PHONE_FORWARD_ROOT 1
+
+#ifdef __GNUC__
+/**
+ * Pobiera z wyprzedzeniem do pamięci podręcznej dane spod adresu
+ */
+#define PHONE_FORWARD_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define PHONE_FORWARD_PREFETCH(address) ((void) (address))
+#endif
+
+/**
+ * @brief Wierzchołek drzewa przekierowań numerów telefonów.
+ * Drzewo jest skompresowanym drzewem TRIE (drzewem radix) - krawędź do
+ * wierzchołka jest etykietowana niepustym ciągiem znaków, a wierzchołki
+ * istnieją tylko tam, gdzie drzewo się rozgałęzia, lub gdzie zaczyna się lub
+ * kończy przekierowanie.
+ * Wierzchołki są przechowywane w arenie bazy, a połączenia między nimi są
+ * 32-bitowymi indeksami w tej arenie. Synowie są zapisani zwięźle: maska
+ * @p childMask mówi, dla których znaków istnieje syn, a ich indeksy leżą
+ * kolejno (według znaków) w tablicy, której pozycję wyznacza liczba
+ * zapalonych bitów maski.
+ */
+struct PhoneForwardNode {
+    /**@{*/
+
+    int depth;
+    /**<
+     * Długość słowa reprezentowanego przez wierzchołek. W korzeniu jest to 0.
+     */
+
+    uint32_t prev;
+    /**<
+     * Indeks ojca w drzewie.
+     * W korzeniu jest to @ref PHONE_FORWARD_NULL.
+     */
+
+    uint32_t children;
+    /**<
+     * Jeśli wierzchołek ma dokładnie jednego syna, to jest to jego indeks.
+     * Jeśli ma ich @c k > 1, to jest to indeks tablicy @c k indeksów synów w
+     * arenie @c childArrays[k] bazy.
+     */
+
+    uint32_t forwardTo;
+    /**<
+     * Indeks wierzchołka do którego idzie bezpośrednie przekierowanie z
+     * danego wierzchołka.
+     * Wartość @ref PHONE_FORWARD_NULL, jeśli z danego wierzchołka nie ma
+     * bezpośredniego przekierowania.
+     */
+
+    uint32_t forwardAncestor;
+    /**<
+     * Indeks najgłębszego wierzchołka na ścieżce od korzenia do tego
+     * wierzchołka (włącznie), z którego istnieje przekierowanie, lub
+     * @ref PHONE_FORWARD_NULL, jeśli takiego nie ma.
+     */
+
+    uint32_t forwardCount;
+    /**<
+     * Liczba przekierowań z wierzchołków poddrzewa tego wierzchołka
+     * (włącznie z nim).
+     */
+
+    uint32_t revertCount;
+    /**<
+     * Liczba przekierowań na wierzchołki poddrzewa tego wierzchołka
+     * (włącznie z nim).
+     */
+
+    uint32_t revert;
+    /**<
+     * Indeks pierwszego wierzchołka listy wierzchołków przekierowanych na
+     * ten wierzchołek. Wartość @ref PHONE_FORWARD_NULL, jeśli lista jest
+     * pusta.
+     */
+
+    uint32_t revertPrev;
+    /**<
+     * Indeks poprzedniego wierzchołka na liście odwrotności przekierowań
+     * wierzchołka @p forwardTo, lub @ref PHONE_FORWARD_NULL.
+     */
+
+    uint32_t revertNext;
+    /**<
+     * Indeks następnego wierzchołka na liście odwrotności przekierowań
+     * wierzchołka @p forwardTo, lub @ref PHONE_FORWARD_NULL.
+     */
+
+    uint16_t childMask;
+    /**<
+     * Maska synów - bit @c i jest zapalony, jeśli istnieje syn, którego
+     * etykieta zaczyna się od znaku @c FIRST_LETTER + @c i.
+     */
+
+    uint8_t labelLength;
+    /**<
+     * Długość etykiety krawędzi od ojca. W korzeniu jest to 0.
+     */
+
+    char label[PHONE_FORWARD_LABEL_CAPACITY];
+    /**<
+     * Etykieta krawędzi od ojca - ostatnie @p labelLength znaków słowa
+     * reprezentowanego przez wierzchołek. Nie jest zakończona znakiem
+     * @c '\0'.
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Grupa nietrywialnych wierzchołków.
+ * Element tablicy z haszowaniem, w której wierzchołki z niepustą listą
+ * odwrotności przekierowań są pogrupowane według głębokości i zbioru cyfr
+ * występujących w reprezentowanym słowie. Zwykle wystarcza to do
+ * wyznaczenia wyniku @ref phfwdNonTrivialCount bez przechodzenia drzewa.
+ */
+struct PhoneForwardNonTrivialEntry {
+    /**@{*/
+
+    int depth;
+    /**<
+     * Głębokość wierzchołków grupy, lub @c 0, jeśli element jest pusty.
+     */
+
+    uint16_t mask;
+    /**<
+     * Maska cyfr - bit @c i jest zapalony, jeśli w słowie występuje znak
+     * @c FIRST_LETTER + @c i.
+     */
+
+    size_t nodes;
+    /**<
+     * Liczba nietrywialnych wierzchołków w grupie.
+     */
+
+    size_t first;
+    /**<
+     * Liczba tych wierzchołków grupy, których żaden właściwy przodek nie jest
+     * nietrywialny. Nieaktualna, jeśli w bazie jest ustawione
+     * @p nonTrivialStale.
+     */
+
+    /**@}*/
+};
+
+/**
+ * Liczba zapamiętywanych wyników @ref phfwdNonTrivialCount.
+ */
+#define NON_TRIVIAL_CACHE_SIZE 16
+
+/**
+ * @brief Zapamiętany wynik @ref phfwdNonTrivialCount.
+ */
+struct PhoneForwardNonTrivialCacheEntry {
+    /**@{*/
+
+    uint64_t version;
+    /**<
+     * Wersja bazy, dla której wynik został obliczony, lub @c 0, jeśli nie
+     * ma zapamiętanego wyniku.
+     */
+
+    size_t length;
+    /**<
+     * Długość zliczanych numerów.
+     */
+
+    uint32_t mask;
+    /**<
+     * Maska dozwolonych cyfr.
+     */
+
+    size_t result;
+    /**<
+     * Zapamiętany wynik.
+     */
+
+    /**@}*/
+};
 
 /**
  * @brief Struktura przechowująca przekierowania numerów telefonów.
  * Przekierowania numerów telefonów reprezentuję jako drzewo TRIE numerów
- * telefonów, w którym trzymam potrzebne informacje o numerach
+ * telefonów, w którym trzymam potrzebne informacje o numerach. Wierzchołki
+ * drzewa i tablice ich synów są przydzielane z aren należących do bazy, dzięki
+ * czemu usunięcie bazy zwalnia tylko bloki aren.
  */
 struct PhoneForward {
     /**@{*/
 
-    int depth;
+    struct SlabArena nodes;
     /**<
-     * Głębokość w drzewie (równa długości słowa). W korzeniu jest to 0.
+     * Arena wierzchołków drzewa typu @ref PhoneForwardNode.
      */
 
-    char nodeChar;
+    struct SlabArena childArrays[SIZE_OF_ALPHABET + 1];
     /**<
-     * Ostatni znak numeru telefonu kończącego się w tym miejscu.
-     * W korzniu jest to @c '\0'.
+     * Areny tablic indeksów synów - arena @c k przechowuje tablice długości
+     * @c k. Areny @c 0 i @c 1 nie są używane.
      */
 
-    struct PhoneForward *prev;
+    uint32_t *pending;
     /**<
-     * Wskaźnik na ojca w drzewie.
-     * W korzeniu jest to @c NULL.
+     * Tablica indeksów wierzchołków, które mogły przestać być potrzebne i
+     * czekają na sprawdzenie w @ref phoneForwardCollectPending.
      */
 
-    struct PhoneForward *nextLetter[SIZE_OF_ALPHABET];
+    size_t pendingCount;
     /**<
-     * Wskaźniki na synów w drzewie - po jednym na każdy możliwy znak.
+     * Liczba indeksów w tablicy @p pending.
      */
 
-    struct PhoneForward *forwardTo;
+    size_t pendingCapacity;
     /**<
-     * Wskaźnik na wierzchołek do którego idzie bezpośrednie przekierowanie z
-     * danego wierzchołka.
-     * Wartość @c NULL, jeśli z danego wierzchołka nie ma bezpośredniego
-     * przekierowania.
+     * Rozmiar tablicy @p pending.
+     */
+
+    struct PhoneForwardNonTrivialEntry *nonTrivial;
+    /**<
+     * Tablica z haszowaniem grup nietrywialnych wierzchołków, rozmiaru
+     * będącego potęgą dwójki, lub @c NULL.
+     */
+
+    size_t nonTrivialCapacity;
+    /**<
+     * Rozmiar tablicy @p nonTrivial.
+     */
+
+    size_t nonTrivialUsed;
+    /**<
+     * Liczba niepustych elementów tablicy @p nonTrivial.
+     */
+
+    int nonTrivialMaxDepth;
+    /**<
+     * Ograniczenie górne głębokości grup w tablicy @p nonTrivial.
      */
 
-    struct PhoneForwardList *revert;
+    bool nonTrivialStale;
     /**<
-     * Wskaźnik na listę przechowywującą możliwe przekierowania z tego
-     * wierzchołka.
+     * Informacja, czy pola @p first grup trzeba wyznaczyć od nowa, bo zmienił
+     * się wierzchołek, pod którym są nietrywialne wierzchołki.
+     */
+
+    uint64_t nonTrivialWalkVersion;
+    /**<
+     * Wersja bazy, dla której zliczanie przeszło drzewo zamiast wyznaczać od
+     * nowa pola @p first grup, lub @c 0.
+     */
+
+    uint64_t version;
+    /**<
+     * Wersja bazy, zwiększana przy każdej zmianie przekierowań. Zaczyna się
+     * od @c 1.
+     */
+
+    struct PhoneForwardNonTrivialCacheEntry
+            nonTrivialCache[NON_TRIVIAL_CACHE_SIZE];
+    /**<
+     * Ostatnie wyniki @ref phfwdNonTrivialCount, w miejscach wyznaczonych
+     * przez maskę cyfr i długość.
      */
 
     /**@}*/
 };
 
+/**
+ * @brief Liczy zapalone bity.
+ * @param mask – maska bitowa.
+ * @return Liczba zapalonych bitów w @p mask.
+ */
+static inline unsigned phoneForwardBitCount(uint32_t mask) {
+    mask = mask - ((mask >> 1) & 0x55555555u);
+    mask = (mask & 0x33333333u) + ((mask >> 2) & 0x33333333u);
+    return (((mask + (mask >> 4)) & 0x0F0F0F0Fu) * 0x01010101u) >> 24;
+}
+
+/**
+ * @brief Wyznacza najniższy zapalony bit.
+ * @param mask – niezerowa maska bitowa.
+ * @return Numer najniższego zapalonego bitu w @p mask.
+ */
+static inline unsigned phoneForwardLowestBit(uint32_t mask) {
+    return phoneForwardBitCount((mask & -mask) - 1);
+}
+
+/**
+ * @brief Udostępnia wierzchołek.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param index – indeks wierzchołka różny od @ref PHONE_FORWARD_NULL.
+ * @return Wskaźnik na wierzchołek o danym indeksie.
+ */
+static inline struct PhoneForwardNode *phoneForwardNode(
+        struct PhoneForward const *phoneForward, uint32_t index) {
+    return slabArenaGet(&phoneForward->nodes, index);
+}
+
+/**
+ * @brief Udostępnia tablicę synów wierzchołka.
+ * Synowie są w niej ułożeni rosnąco według swoich znaków, tak jak zapalone
+ * bity maski @c childMask wierzchołka.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – wskaźnik na wierzchołek.
+ * @return Wskaźnik na tablicę indeksów synów wierzchołka @p node.
+ */
+static inline uint32_t *phoneForwardChildArray(
+        struct PhoneForward const *phoneForward,
+        struct PhoneForwardNode *node) {
+    unsigned count = phoneForwardBitCount(node->childMask);
+
+    if (count <= 1)
+        return &node->children;
+    return slabArenaGet(&phoneForward->childArrays[count], node->children);
+}
+
+/**
+ * @brief Znajduje syna wierzchołka.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – wskaźnik na wierzchołek;
+ * @param letter – numer pierwszego znaku etykiety syna, od @c 0 do
+ *                 @ref SIZE_OF_ALPHABET - 1.
+ * @return Indeks syna wierzchołka @p node dla znaku @p letter, lub
+ *         @ref PHONE_FORWARD_NULL, jeśli takiego syna nie ma.
+ */
+static inline uint32_t phoneForwardChild(
+        struct PhoneForward const *phoneForward,
+        struct PhoneForwardNode *node, unsigned letter) {
+    uint32_t bit = 1u << letter;
+
+    if (!(node->childMask & bit))
+        return PHONE_FORWARD_NULL;
+    return phoneForwardChildArray(phoneForward, node)[phoneForwardBitCount(
+            node->childMask & (bit - 1))];
+}
+
+/**
+ * @brief Zmienia najbliższy wierzchołek z przekierowaniem w poddrzewie.
+ * Ustawia pole @p forwardAncestor na @p to w wierzchołku @p node i tych jego
+ * potomkach, w których ma ono wartość @p from. Poddrzewa wierzchołków z
+ * inną wartością (czyli poniżej innego przekierowania) są pomijane.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks korzenia poddrzewa;
+ * @param from – dotychczasowa wartość pola;
+ * @param to – nowa wartość pola.
+ */
+void phoneForwardSetForwardAncestor(struct PhoneForward *phoneForward,
+                                    uint32_t node, uint32_t from,
+                                    uint32_t to);
+
+/**
+ * @brief Zaznacza wierzchołek do sprawdzenia.
+ * Dopisuje wierzchołek @p node, z którego właśnie usunięto przekierowanie lub
+ * jego odwrotność, do wierzchołków sprawdzanych przez
+ * @ref phoneForwardCollectPending. Jeśli nie uda się zaalokować pamięci, to
+ * wierzchołek po prostu nie zostanie sprawdzony - drzewo pozostaje poprawne.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks wierzchołka, lub @ref PHONE_FORWARD_NULL, który jest
+ *               pomijany.
+ */
+void phoneForwardMarkPending(struct PhoneForward *phoneForward, uint32_t node);
+
+/**
+ * @brief Usuwa niepotrzebne wierzchołki wśród zaznaczonych.
+ * Każdy wierzchołek zaznaczony przez @ref phoneForwardMarkPending, który nie
+ * jest korzeniem i nie ma przekierowania ani jego odwrotności, jest usuwany,
+ * jeśli jest liściem (po czym to samo dotyczy jego ojca), albo scalany ze swoim
+ * jedynym synem w jedną krawędź. Dzięki temu rozmiar drzewa zależy tylko od
+ * istniejących przekierowań.
+ * @param phoneForward – wskaźnik na bazę.
+ */
+void phoneForwardCollectPending(struct PhoneForward *phoneForward);
+
+/**
+ * @brief Dodaje syna wierzchołka.
+ * Dopisuje wierzchołek @p child jako syna wierzchołka @p node dla znaku
+ * @p letter, dla którego wierzchołek @p node nie ma jeszcze syna.
+ * @param phoneForward – wskaźnik na bazę;
+ * @param node – indeks wierzchołka;
+ * @param letter – numer pierwszego znaku etykiety syna, od @c 0 do
+ *                 @ref SIZE_OF_ALPHABET - 1;
+ * @param child – indeks dopisywanego syna.
+ * @return Wartość @c true, jeśli dodawanie się powiodło, lub wartość
+ *         @c false, jeśli nie udało się zaalokować pamięci.
+ */
+bool phoneForwardAddChild(struct PhoneForward *phoneForward, uint32_t node,
+                          unsigned letter, uint32_t child);
+
 /** @brief Tworzy nową strukturę.
  * Działa jak @ref phfwdNew.
  * Tworzy nową strukturę niezawierającą żadnych przekierowań.
@@ -93,31 +453,73 @@ void phoneForwardDestroy(struct PhoneForward *phoneForward);
 /**
  * @brief Zamienia słowo na wierchołek
  * Zamienia słowo @p number będące numerem telefonu na wierchołke będący jego
- * reprezentacją w drzewie @p phoneForward.
+ * reprezentacją w drzewie @p phoneForward, tworząc brakujące wierzchołki i
+ * dzieląc krawędź, jeśli słowo kończy się w jej środku.
  * @param phoneForward – wskaźnik na drzewo w którym szukamy reprezentacji
  *                       danego słowa;
  * @param number – wskaźnik na słowo.
- * @return Wartość @c NULL jeśli dane słowo nie reprezentuje numeru, lub
- *         wskaźnik na wierzchołek w drzewie reprezentujący dany numer.
+ * @return Wartość @ref PHONE_FORWARD_NULL jeśli dane słowo nie reprezentuje
+ *         numeru lub nie udało się zaalokować pamięci (nowe wierzchołki bez
+ *         przekierowań są wtedy usuwane), albo indeks wierzchołka w drzewie
+ *         reprezentującego dany numer.
+ */
+uint32_t phoneForwardFromString(struct PhoneForward *phoneForward,
+                                char const *number);
+
+/**
+ * @brief Zamienia słowo danej długości na wierchołek
+ * Działa jak @ref phoneForwardFromString dla pierwszych @p length znaków
+ * słowa @p number, które nie musi być zakończone znakiem @c '\0'.
+ * @param phoneForward – wskaźnik na drzewo w którym szukamy reprezentacji
+ *                       danego słowa;
+ * @param number – wskaźnik na słowo;
+ * @param length – długość słowa.
+ * @return Wynik jak w @ref phoneForwardFromString.
+ */
+uint32_t phoneForwardFromStringLength(struct PhoneForward *phoneForward,
+                                      char const *number, size_t length);
+
+/**
+ * @brief Znajduje najdłuższy istniejący prefiks słowa
+ * Schodzi w dół drzewa @p phoneForward po kolejnych znakach słowa @p number
+ * tak długo, jak istnieją odpowiednie wierzchołki, a etykiety krawędzi
+ * zgadzają się ze słowem w całości. W przeciwieństwie do
+ * @ref phoneForwardFromString nie tworzy żadnych nowych wierzchołków.
+ * @param phoneForward – wskaźnik na drzewo w którym szukamy reprezentacji
+ *                       danego słowa;
+ * @param number – wskaźnik na słowo.
+ * @return Indeks najgłębszego wierzchołka w drzewie reprezentującego prefiks
+ *         słowa @p number, lub @ref PHONE_FORWARD_NULL, jeśli któryś z
+ *         parametrów ma wartość @c NULL. Długość znalezionego prefiksu to
+ *         głębokość wierzchołka.
+ */
+uint32_t phoneForwardFindLongestPrefix(struct PhoneForward *phoneForward,
+                                       char const *number);
+
+/**
+ * @brief Zapisuje numer reprezentowany przez wierzchołek.
+ * Zapisuje do @p destination napis reprezentujący numer od korzenia
+ * (wyłącznie) do wierchołka @p end (włącznie), bez kończącego znaku
+ * @c '\0'.
+ * @param phoneForward – wskaźnik na drzewo zawierające wierzchołek @p end;
+ * @param end – indeks wierzchołka w drzewie;
+ * @param[out] destination – wskaźnik na miejsce na co najmniej tyle znaków,
+ *                           ile wynosi głębokość wierzchołka @p end.
  */
-struct PhoneForward *phoneForwardFromString(struct PhoneForward *phoneForward,
-                                            char const *number);
+void phoneForwardWriteString(struct PhoneForward *phoneForward, uint32_t end,
+                             char *destination);
 
 /**
- * @brief Zamienia wierchołki na słowo
+ * @brief Zamienia wierchołek i słowo na słowo
  * Tworzy słowo będące połączeniem dwóch słów - pierwsza jego część to
- * napis reprezentujący numer od wierchołka begin1 (wyłącznie) do wierchołka
- * end1 (włącznie), a druga to napis reprezentujący numer of wierchołka begin2
- * (wyłącznie) do wierchołka end2 (włącznie).
- * @param begin1 – wskaźnik na pierwszy wierchołek w drzewie;
- * @param end1 – wskaźnik na drugi wierzhołek w drzewie, będący synem @p begin1;
- * @param begin2 – wskaźnik na trzeci wierzchołek w drzewie;
- * @param end2 – wskaźnik na czwarty wierchołek w drzewie będący synem @p begin2.
+ * napis reprezentujący numer od korzenia (wyłącznie) do wierchołka @p end
+ * (włącznie), a druga to słowo @p suffix.
+ * @param phoneForward – wskaźnik na drzewo zawierające wierzchołek @p end;
+ * @param end – indeks wierzchołka w drzewie;
+ * @param suffix – wskaźnik na słowo dopisywane na końcu.
  * @return Szukane słowo, lub @c NULL, gdy nie udało się zaalokować pamięci.
  */
-char *phoneForwardToString(struct PhoneForward *begin1,
-                           struct PhoneForward *end1,
-                           struct PhoneForward *begin2,
-                           struct PhoneForward *end2);
+char *phoneForwardToString(struct PhoneForward *phoneForward, uint32_t end,
+                           char const *suffix);
 
 #endif //TEL_PHONE_FORWARD_BASIC_H
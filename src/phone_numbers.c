@@ -1,57 +1,243 @@
 /** @file
  * Implementacja operacji na strukturze @c PhoneNumbers z interfejsem w
- * pliku @ref string_list.h
+ * pliku @ref phone_numbers.h
  *
  * @author Witalis Domitrz <witekdomitrz@gmail.com>
  * @date 13.05.2018
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "phone_numbers.h"
+#include "phone_forward_struct.h"
+
+/**
+ * Liczba napisów, poniżej której sortowanie pozycyjne jest zastępowane
+ * sortowaniem przez wstawianie
+ */
+#define RADIX_SORT_THRESHOLD 16
+
+/**
+ * Liczba kubełków sortowania pozycyjnego - koniec napisu i kolejne cyfry
+ */
+#define RADIX_SORT_BUCKETS (SIZE_OF_ALPHABET + 1)
+
+struct PhoneNumbers *phoneNumbersAllocate(size_t size, size_t length,
+                                          char const ***sequence,
+                                          char **characters) {
+    struct PhoneNumbers *newPhoneNumbers;
+
+    // Zaalokowanie struktury, tablicy i napisów razem
+    newPhoneNumbers = malloc(sizeof(struct PhoneNumbers) +
+                             size * sizeof(char const *) + length);
+    if (newPhoneNumbers == NULL)
+        return NULL;
+
+    // Ustawienie wskaźników na kolejne części bloku
+    *sequence = (char const **) (newPhoneNumbers + 1);
+    *characters = (char *) (*sequence + size);
+    newPhoneNumbers->sequence = *sequence;
+    newPhoneNumbers->size = size;
+    return newPhoneNumbers;
+}
 
 struct PhoneNumbers *phoneNumbersCreate(char const *const *sequence,
                                         size_t size) {
     struct PhoneNumbers *newPhoneNumbers;
-    size_t i;
-
-    // Stworzenie nowej struktury
-    newPhoneNumbers = malloc(sizeof(struct PhoneNumbers));
-    if (newPhoneNumbers == NULL) {
-        // Zwolnienie ciągu w przypadku błędu alokacji
-        for (i = 0; i < size; i++) {
-            free((void *) sequence[i]);
-        }
-        free((void *) sequence);
-        return NULL;
+    char const **newSequence;
+    char *characters;
+    size_t i, length, currentLength;
+
+    // Policzenie łącznej długości napisów
+    length = 0;
+    for (i = 0; i < size; i++)
+        length += strlen(sequence[i]) + 1;
+
+    // Stworzenie nowej struktury i przepisanie do niej napisów
+    newPhoneNumbers = phoneNumbersAllocate(size, length, &newSequence,
+                                           &characters);
+    for (i = 0; i < size && newPhoneNumbers != NULL; i++) {
+        currentLength = strlen(sequence[i]) + 1;
+        memcpy(characters, sequence[i], currentLength);
+        newSequence[i] = characters;
+        characters += currentLength;
     }
 
-    // Ustawienie parametrów
-    newPhoneNumbers->sequence = sequence;
-    newPhoneNumbers->size = size;
+    // Zwolnienie ciągu, również w przypadku błędu alokacji
+    for (i = 0; i < size; i++) {
+        free((void *) sequence[i]);
+    }
+    free((void *) sequence);
 
     // Zwrócenie nowaj struktury
     return newPhoneNumbers;
 }
 
-struct PhoneNumbers *phoneNumbersCreateEmpty() {
-    // Pusty ciąg to ciąg o zerowej długości ze wskaźnikiem na NULL.
-    return phoneNumbersCreate(NULL, 0);
+/**
+ * @brief Zwraca kubełek znaku napisu.
+ * @param buffer – bufor z napisami;
+ * @param offset – pozycja początku napisu w buforze;
+ * @param position – pozycja znaku w napisie, nie dalsza niż jego koniec.
+ * @return Wartość @c 0 dla końca napisu, a dla cyfry jej numer zwiększony o
+ *         @c 1.
+ */
+unsigned phoneNumbersBucket(char const *buffer, size_t offset,
+                            size_t position) {
+    char c = buffer[offset + position];
+    return c == '\0' ? 0 : (unsigned) (c - FIRST_LETTER) + 1;
 }
 
-void phoneNumbersDelete(struct PhoneNumbers const *phoneNumbers) {
-    size_t i;
+/**
+ * @brief Sortuje napisy przez wstawianie.
+ * Sortuje pozycje napisów z bufora @p buffer, które mają wspólny prefiks
+ * długości @p position.
+ * @param buffer – bufor z napisami;
+ * @param[in, out] offsets – tablica pozycji początków napisów;
+ * @param size – liczba napisów;
+ * @param position – długość wspólnego prefiksu napisów.
+ */
+void phoneNumbersInsertionSort(char const *buffer, size_t *offsets,
+                               size_t size, size_t position) {
+    size_t i, j, current;
 
-    // Sprawdzenie poprawności wejścia
-    if (phoneNumbers == NULL)
-        return;
+    for (i = 1; i < size; i++) {
+        current = offsets[i];
+        for (j = i; j > 0 && strcmp(buffer + offsets[j - 1] + position,
+                                    buffer + current + position) > 0; j--)
+            offsets[j] = offsets[j - 1];
+        offsets[j] = current;
+    }
+}
 
-    // Zwolnienie wszystkich słów
-    for (i = 0; i < phoneNumbers->size; i++) {
-        free((void *) phoneNumbers->sequence[i]);
+/**
+ * @brief Sortuje napisy pozycyjnie.
+ * Sortuje pozycje napisów z bufora @p buffer, które mają wspólny prefiks
+ * długości @p position, rozdzielając je na kubełki według kolejnych znaków
+ * (od najbardziej znaczącego). Rekurencja dotyczy tylko mniejszych kubełków,
+ * a największy jest sortowany w pętli, więc głębokość rekurencji jest
+ * logarytmiczna względem liczby napisów.
+ * @param buffer – bufor z napisami;
+ * @param[in, out] offsets – tablica pozycji początków napisów;
+ * @param helper – tablica pomocnicza rozmiaru co najmniej @p size;
+ * @param size – liczba napisów;
+ * @param position – długość wspólnego prefiksu napisów.
+ */
+void phoneNumbersRadixSort(char const *buffer, size_t *offsets, size_t *helper,
+                           size_t size, size_t position) {
+    size_t counts[RADIX_SORT_BUCKETS], starts[RADIX_SORT_BUCKETS];
+    size_t i, largestStart, largestSize;
+    unsigned bucket, largest;
+
+    while (size >= RADIX_SORT_THRESHOLD) {
+        // Zliczenie napisów w kubełkach
+        for (bucket = 0; bucket < RADIX_SORT_BUCKETS; bucket++)
+            counts[bucket] = 0;
+        for (i = 0; i < size; i++)
+            counts[phoneNumbersBucket(buffer, offsets[i], position)]++;
+
+        // Rozłożenie napisów do kubełków
+        starts[0] = 0;
+        for (bucket = 1; bucket < RADIX_SORT_BUCKETS; bucket++)
+            starts[bucket] = starts[bucket - 1] + counts[bucket - 1];
+        for (i = 0; i < size; i++)
+            helper[starts[phoneNumbersBucket(buffer, offsets[i], position)]++] =
+                    offsets[i];
+        memcpy(offsets, helper, size * sizeof(size_t));
+
+        /*
+         * Kubełek 0 zawiera równe sobie napisy, które się skończyły. Pozostałe
+         * kubełki są sortowane dalej od następnego znaku.
+         */
+        largest = 0;
+        for (bucket = 1; bucket < RADIX_SORT_BUCKETS; bucket++)
+            if (counts[bucket] > counts[largest])
+                largest = bucket;
+        if (largest == 0)
+            return;
+        for (bucket = 1; bucket < RADIX_SORT_BUCKETS; bucket++) {
+            if (bucket == largest || counts[bucket] < 2)
+                continue;
+            phoneNumbersRadixSort(buffer,
+                                  offsets + starts[bucket] - counts[bucket],
+                                  helper, counts[bucket], position + 1);
+        }
+
+        largestSize = counts[largest];
+        largestStart = starts[largest] - largestSize;
+        offsets += largestStart;
+        size = largestSize;
+        position++;
+    }
+
+    phoneNumbersInsertionSort(buffer, offsets, size, position);
+}
+
+size_t phoneNumbersSortUnique(char const *buffer, size_t *offsets,
+                              size_t *helper, size_t size) {
+    size_t i, unique;
+
+    // Posortowanie pozycji napisów
+    if (size >= RADIX_SORT_THRESHOLD)
+        phoneNumbersRadixSort(buffer, offsets, helper, size, 0);
+    else
+        phoneNumbersInsertionSort(buffer, offsets, size, 0);
+
+    // Usunięcie powtórzeń - równe napisy są teraz obok siebie
+    unique = 0;
+    for (i = 0; i < size; i++) {
+        if (unique > 0 &&
+            strcmp(buffer + offsets[unique - 1], buffer + offsets[i]) == 0)
+            continue;
+        offsets[unique++] = offsets[i];
     }
+    return unique;
+}
+
+struct PhoneNumbers *phoneNumbersCreateSorted(char const *buffer,
+                                              size_t *offsets, size_t size) {
+    struct PhoneNumbers *newPhoneNumbers;
+    char const **sequence;
+    char *characters;
+    size_t *helper;
+    size_t i, unique, length, currentLength;
 
-    // Zwolnienie tablicy słów i struktury
-    free((void *) phoneNumbers->sequence);
+    // Posortowanie pozycji napisów bez powtórzeń
+    helper = NULL;
+    if (size >= RADIX_SORT_THRESHOLD) {
+        helper = malloc(size * sizeof(size_t));
+        if (helper == NULL)
+            return NULL;
+    }
+    unique = phoneNumbersSortUnique(buffer, offsets, helper, size);
+    free(helper);
+
+    // Przepisanie napisów do nowej struktury
+    length = 0;
+    for (i = 0; i < unique; i++)
+        length += strlen(buffer + offsets[i]) + 1;
+    newPhoneNumbers = phoneNumbersAllocate(unique, length, &sequence,
+                                           &characters);
+    if (newPhoneNumbers == NULL)
+        return NULL;
+    for (i = 0; i < unique; i++) {
+        currentLength = strlen(buffer + offsets[i]) + 1;
+        memcpy(characters, buffer + offsets[i], currentLength);
+        sequence[i] = characters;
+        characters += currentLength;
+    }
+    return newPhoneNumbers;
+}
+
+struct PhoneNumbers *phoneNumbersCreateEmpty() {
+    // Pusty ciąg to ciąg o zerowej długości.
+    return phoneNumbersCreate(NULL, 0);
+}
+
+void phoneNumbersDelete(struct PhoneNumbers const *phoneNumbers) {
+    /*
+     * Tablica słów i słowa są w tym samym bloku co struktura, a free nic nie
+     * robi dla wartości NULL.
+     */
     free((void *) phoneNumbers);
 }
 
@@ -68,4 +254,3 @@ char const *phoneNumbersGet(struct PhoneNumbers const *phoneNumbers,
     // Zwrócenie wartości w danym miejscu
     return phoneNumbers->sequence[idx];
 }
-
@@ -1,6 +1,6 @@
 /** @file
  * Interfejs operacji i deklaracja struktury @c PhoneNumbers z implementacją w
- * pliku @ref string_list.c
+ * pliku @ref phone_numbers.c
  *
  * @author Witalis Domitrz <witekdomitrz@gmail.com>
  * @date 13.05.2018
@@ -14,7 +14,8 @@
 /**
  * @brief Struktura przechowująca ciąg numerów telefonów.
  * Struktura przechowująca ciąg numerów telefonów reprezentowany przez swoją
- * długość oraz tablicę jego elementów w postaci napisów.
+ * długość oraz tablicę jego elementów w postaci napisów. Struktura, tablica i
+ * napisy zajmują jeden blok pamięci.
  */
 struct PhoneNumbers {
     /**@{*/
@@ -35,7 +36,8 @@ struct PhoneNumbers {
 /**
  * @brief Tworzy nową stukturę.
  * Tworzy nową stukturę @c PhoneNumbers na podstawie podanego ciągu i jego
- * długości.
+ * długości. Napisy ciągu są kopiowane do struktury, a ciąg i jego napisy
+ * zwalniane.
  * @param sequence – ciąg do zapisania w strukturze
  * @param size – długość ciągu do zapisania w strukturze
  * @return Wskaźnik na nowoutworzoną strukturę, lub @c NULL, gdy nie udało się
@@ -44,6 +46,54 @@ struct PhoneNumbers {
 struct PhoneNumbers *phoneNumbersCreate(char const *const *sequence,
                                         size_t size);
 
+/**
+ * @brief Tworzy pustą strukturę danego rozmiaru.
+ * Alokuje jednym blokiem strukturę @c PhoneNumbers, tablicę na @p size
+ * napisów i miejsce na @p length znaków tych napisów. Tablicę i znaki wypełnia
+ * wywołujący.
+ * @param size – liczba napisów;
+ * @param length – łączna długość napisów razem ze znakami @c '\0';
+ * @param[out] sequence – wskaźnik na zmienną, do której zostanie zapisany
+ *                        wskaźnik na tablicę napisów;
+ * @param[out] characters – wskaźnik na zmienną, do której zostanie zapisany
+ *                          wskaźnik na miejsce na znaki.
+ * @return Wskaźnik na nowoutworzoną strukturę, lub @c NULL, gdy nie udało się
+ *         zaalokować pamięci.
+ */
+struct PhoneNumbers *phoneNumbersAllocate(size_t size, size_t length,
+                                          char const ***sequence,
+                                          char **characters);
+
+/**
+ * @brief Sortuje napisy i usuwa powtórzenia.
+ * Sortuje leksykograficznie pozycje napisów zapisanych w buforze @p buffer i
+ * zostawia na początku tablicy @p offsets pozycje napisów bez powtórzeń.
+ * Napisy mogą składać się tylko ze znaków od @c FIRST_LETTER do
+ * @c LAST_LETTER. Nie alokuje pamięci.
+ * @param buffer – bufor zawierający napisy zakończone znakiem @c '\0';
+ * @param[in, out] offsets – tablica pozycji początków napisów w buforze;
+ * @param helper – tablica pomocnicza rozmiaru co najmniej @p size;
+ * @param size – liczba napisów.
+ * @return Liczba różnych napisów.
+ */
+size_t phoneNumbersSortUnique(char const *buffer, size_t *offsets,
+                              size_t *helper, size_t size);
+
+/**
+ * @brief Tworzy nową stukturę z posortowanym ciągiem.
+ * Tworzy nową stukturę @c PhoneNumbers zawierającą napisy zapisane w buforze
+ * @p buffer, posortowane leksykograficznie i bez powtórzeń. Napisy mogą
+ * składać się tylko ze znaków od @c FIRST_LETTER do @c LAST_LETTER.
+ * @param buffer – bufor zawierający napisy zakończone znakiem @c '\0';
+ * @param[in, out] offsets – tablica pozycji początków napisów w buforze,
+ *                           która zostaje posortowana;
+ * @param size – liczba napisów.
+ * @return Wskaźnik na nowoutworzoną strukturę, lub @c NULL, gdy nie udało się
+ *         zaalokować pamięci.
+ */
+struct PhoneNumbers *phoneNumbersCreateSorted(char const *buffer,
+                                              size_t *offsets, size_t size);
+
 /**
  * @brief Tworzy nową stukturę.
  * Tworzy nową stukturę @c PhoneNumbers reprezentującą pusty ciąg.
@@ -0,0 +1,725 @@
+/** @file
+ * Implementacja potokowego wykonywania operacji z interfejsem w
+ * @ref pipeline.h
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "pipeline.h"
+#include "operation.h"
+#include "input_reader.h"
+#include "output_writer.h"
+
+/**
+ * Liczba operacji w buforze cyklicznym pomiędzy wątkami
+ */
+#define PIPELINE_SIZE 1024
+
+/**
+ * Liczba operacji, po której wczytaniu są one przekazywane do wykonania
+ */
+#define PIPELINE_BATCH 256
+
+/**
+ * Wynik operacji z jednego miejsca bufora przy wykonywaniu w wątkach baz.
+ */
+struct PipelineSlot {
+
+    /**@{*/
+
+    struct PhoneForward *base;
+    /**<
+     * Baza, na której wykonywana jest operacja.
+     */
+
+    int result;
+    /**<
+     * Wynik @ref operationExecute.
+     */
+
+    atomic_bool done;
+    /**<
+     * Informacja, czy operacja została wykonana i @p result jest ustawiony.
+     */
+
+    /**@}*/
+};
+
+/**
+ * Stan potoku współdzielony przez wątek wczytujący i wykonujący.
+ */
+struct Pipeline {
+
+    /**@{*/
+
+    pthread_mutex_t mutex;
+    /**<
+     * Muteks chroniący liczniki i flagi potoku.
+     */
+
+    pthread_cond_t ready;
+    /**<
+     * Zmienna warunkowa sygnalizowana po wczytaniu operacji, lub wykonaniu
+     * operacji przez wątek bazy.
+     */
+
+    pthread_cond_t executed;
+    /**<
+     * Zmienna warunkowa sygnalizowana po zwolnieniu miejsca w buforze.
+     */
+
+    struct Operation *operations[PIPELINE_SIZE];
+    /**<
+     * Bufor cykliczny operacji. Operacja numer @c i jest w miejscu
+     * @c i @c % @ref PIPELINE_SIZE.
+     */
+
+    struct PipelineSlot slots[PIPELINE_SIZE];
+    /**<
+     * Wyniki operacji z odpowiednich miejsc bufora, używane przy wykonywaniu w
+     * wątkach baz.
+     */
+
+    size_t parsedCount;
+    /**<
+     * Liczba wczytanych operacji przekazanych do wykonania.
+     */
+
+    size_t pendingCount;
+    /**<
+     * Liczba wczytanych operacji, które nie zostały jeszcze przekazane do
+     * wykonania. Używana tylko przez wątek wczytujący.
+     */
+
+    size_t executedCount;
+    /**<
+     * Liczba wykonanych operacji, których miejsca w buforze są wolne.
+     */
+
+    bool waiting;
+    /**<
+     * Informacja, czy wątek wczytujący zaczął czekać na wejście od ostatniego
+     * opróżnienia bufora wyjścia.
+     */
+
+    bool finished;
+    /**<
+     * Informacja, czy wątek wczytujący skończył pracę.
+     */
+
+    bool stopped;
+    /**<
+     * Informacja, czy wątek wykonujący przerwał pracę po błędzie.
+     */
+
+    int inputCharacterNumber;
+    /**<
+     * Liczba znaków wczytanych przez wątek wczytujący.
+     */
+
+    /**@}*/
+};
+
+/**
+ * Wątek wykonujący operacje na przydzielonych mu bazach.
+ */
+struct PipelineWorker {
+
+    /**@{*/
+
+    pthread_t thread;
+    /**<
+     * Identyfikator wątku.
+     */
+
+    pthread_mutex_t mutex;
+    /**<
+     * Muteks chroniący kolejkę wątku.
+     */
+
+    pthread_cond_t ready;
+    /**<
+     * Zmienna warunkowa sygnalizowana po dodaniu operacji do kolejki, lub
+     * zakończeniu pracy.
+     */
+
+    size_t queue[PIPELINE_SIZE];
+    /**<
+     * Kolejka cykliczna miejsc bufora potoku z operacjami do wykonania.
+     */
+
+    size_t queuedCount;
+    /**<
+     * Liczba operacji dodanych do kolejki.
+     */
+
+    bool stopping;
+    /**<
+     * Informacja, czy wątek ma zakończyć pracę po wykonaniu kolejki.
+     */
+
+    struct Pipeline *pipeline;
+    /**<
+     * Wskaźnik na strukturę potoku.
+     */
+
+    struct PhoneForwardPool *pool;
+    /**<
+     * Pula wątków używanych przez operację @c NTRIV, lub @c NULL.
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Sprawdza, czy operacja jest błędem wczytywania.
+ * Po takiej operacji nie ma sensu wczytywać dalszego wejścia.
+ * @param operation – wskaźnik na wczytaną operację.
+ * @return Wartość @c true, jeśli operacja jest błędem wczytywania, lub wartość
+ *         @c false w przeciwnym przypadku.
+ */
+static bool pipelineIsParsingError(struct Operation *operation) {
+    return operation->typeOfOperation == MEMORY_ERROR ||
+           operation->typeOfOperation == PARSING_ERROR ||
+           operation->typeOfOperation == EOF_ERROR;
+}
+
+/**
+ * @brief Przekazuje wczytane operacje do wykonania.
+ * Wymaga zablokowanego muteksu potoku.
+ * @param pipeline – wskaźnik na strukturę potoku.
+ */
+static void pipelinePublish(struct Pipeline *pipeline) {
+    if (pipeline->pendingCount == 0)
+        return;
+    pipeline->parsedCount += pipeline->pendingCount;
+    pipeline->pendingCount = 0;
+    pthread_cond_signal(&pipeline->ready);
+}
+
+/**
+ * @brief Przekazuje wczytane operacje do wykonania przed czekaniem na wejście.
+ * Wywoływana przez wątek wczytujący z @ref inputReaderSetFillCallback, żeby
+ * przy pracy interaktywnej operacje nie czekały na kolejne wejście, a ich
+ * wyniki zostały wypisane, gdy tylko zostaną wykonane.
+ * @param argument – wskaźnik na strukturę potoku.
+ */
+static void pipelineBeforeFill(void *argument) {
+    struct Pipeline *pipeline;
+
+    pipeline = argument;
+    pthread_mutex_lock(&pipeline->mutex);
+    pipelinePublish(pipeline);
+    pipeline->waiting = true;
+    pthread_cond_signal(&pipeline->ready);
+    pthread_mutex_unlock(&pipeline->mutex);
+}
+
+/**
+ * @brief Funkcja wątku wczytującego.
+ * Wczytuje kolejne operacje do wolnych miejsc bufora, aż do końca wejścia,
+ * błędu wczytywania, lub przerwania przez wątek wykonujący. Operacje są
+ * przekazywane do wykonania najwyżej po @ref PIPELINE_BATCH naraz, lub
+ * wcześniej przed czekaniem na wejście. Wątek może zostać anulowany tylko w
+ * czasie czekania na wejście.
+ * @param argument – wskaźnik na strukturę potoku.
+ * @return Wartość @c NULL.
+ */
+static void *pipelineParse(void *argument) {
+    struct Pipeline *pipeline;
+    struct Operation *operation;
+    size_t available, i;
+    bool read;
+    int state;
+
+    pipeline = argument;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    while (true) {
+
+        // Przekazanie operacji i czekanie na wolne miejsce w buforze
+        pthread_mutex_lock(&pipeline->mutex);
+        pipelinePublish(pipeline);
+        while (pipeline->parsedCount - pipeline->executedCount ==
+               PIPELINE_SIZE && !pipeline->stopped)
+            pthread_cond_wait(&pipeline->executed, &pipeline->mutex);
+        if (pipeline->stopped) {
+            pipeline->finished = true;
+            pthread_mutex_unlock(&pipeline->mutex);
+            return NULL;
+        }
+        available = PIPELINE_SIZE -
+                    (pipeline->parsedCount - pipeline->executedCount);
+        pthread_mutex_unlock(&pipeline->mutex);
+        if (available > PIPELINE_BATCH)
+            available = PIPELINE_BATCH;
+
+        /*
+         * Wczytanie operacji do wolnych miejsc. Licznik parsedCount zmienia
+         * tylko ten wątek, więc można go czytać bez muteksu. W czasie
+         * czekania na wejście wątek można anulować.
+         */
+        pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &state);
+        for (i = 0; i < available; i++) {
+            operation = pipeline->operations[(pipeline->parsedCount +
+                                              pipeline->pendingCount) %
+                                             PIPELINE_SIZE];
+            read = inputReaderReadNextOperation(
+                    operation, &pipeline->inputCharacterNumber);
+            if (read)
+                pipeline->pendingCount++;
+
+            // Koniec wejścia, lub błąd kończą wczytywanie
+            if (!read || pipelineIsParsingError(operation)) {
+                pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+                pthread_mutex_lock(&pipeline->mutex);
+                pipelinePublish(pipeline);
+                pipeline->finished = true;
+                pthread_cond_signal(&pipeline->ready);
+                pthread_mutex_unlock(&pipeline->mutex);
+                return NULL;
+            }
+        }
+        pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &state);
+    }
+}
+
+/**
+ * @brief Wykonuje operacje wczytywane przez wątek wczytujący.
+ * Wykonuje naraz wszystkie dostępne operacje, a gdy ich nie ma, czeka na
+ * kolejne. Jeśli wątek wczytujący czeka na wejście, to wcześniej opróżnia
+ * bufor wyjścia.
+ * @param pipeline – wskaźnik na strukturę potoku;
+ * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań;
+ * @param pool – pula wątków używanych przez operację @c NTRIV, lub @c NULL.
+ * @return Wartość @c 0, jeśli wszystkie operacje się powiodły, lub wartość
+ *         @c 1, jeśli wystąpił błąd.
+ */
+static int pipelineExecute(struct Pipeline *pipeline,
+                           struct Dictionary *dictionary,
+                           struct PhoneForwardPool *pool) {
+    struct PhoneForward *phoneForward;
+    struct Operation *operation;
+    size_t available, done;
+    int result;
+
+    phoneForward = NULL;
+    pthread_mutex_lock(&pipeline->mutex);
+    while (true) {
+
+        // Czekanie na wczytane operacje
+        while (pipeline->parsedCount == pipeline->executedCount &&
+               !pipeline->finished) {
+            if (pipeline->waiting) {
+                pipeline->waiting = false;
+                pthread_mutex_unlock(&pipeline->mutex);
+                outputWriterFlush();
+                pthread_mutex_lock(&pipeline->mutex);
+                continue;
+            }
+            pthread_cond_wait(&pipeline->ready, &pipeline->mutex);
+        }
+        available = pipeline->parsedCount - pipeline->executedCount;
+        if (available == 0)
+            break;
+        pthread_mutex_unlock(&pipeline->mutex);
+
+        // Wykonanie dostępnych operacji bez blokowania muteksu
+        for (done = 0; done < available; done++) {
+            operation = pipeline->operations[(pipeline->executedCount + done) %
+                                             PIPELINE_SIZE];
+            result = operationExecute(operation, &phoneForward, dictionary,
+                                      pool);
+            if (result != OPERATION_SUCCESS) {
+                operationPrintError(operation, result);
+                return 1;
+            }
+            operationClean(operation);
+        }
+
+        // Zwolnienie miejsc w buforze
+        pthread_mutex_lock(&pipeline->mutex);
+        pipeline->executedCount += available;
+        pthread_cond_signal(&pipeline->executed);
+    }
+    pthread_mutex_unlock(&pipeline->mutex);
+
+    return 0;
+}
+
+/**
+ * @brief Sprawdza, czy operacja działa na aktualnej bazie.
+ * Takie operacje mogą być wykonane w wątku bazy, a pozostałe (zmiana,
+ * usunięcie bazy i błędy) wykonuje wątek rozdzielający.
+ * @param operation – wskaźnik na wczytaną operację.
+ * @return Wartość @c true, jeśli operacja działa na aktualnej bazie, lub
+ *         wartość @c false w przeciwnym przypadku.
+ */
+static bool pipelineIsBaseOperation(struct Operation *operation) {
+    switch (operation->typeOfOperation) {
+        case ADD:
+        case GET:
+        case GET_BATCH:
+        case REV:
+        case DEL:
+        case NTRIV:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Wyznacza wątek bazy.
+ * Wszystkie operacje na danej bazie trafiają do tego samego wątku, więc są
+ * wykonywane w kolejności wczytania.
+ * @param base – wskaźnik na bazę;
+ * @param workersCount – liczba wątków baz.
+ * @return Numer wątku bazy.
+ */
+static unsigned pipelineWorkerOf(struct PhoneForward *base,
+                                 unsigned workersCount) {
+    uint64_t hash;
+
+    hash = (uint64_t) (uintptr_t) base * UINT64_C(0x9E3779B97F4A7C15);
+    return (unsigned) ((hash >> 32) % workersCount);
+}
+
+/**
+ * @brief Funkcja wątku bazy.
+ * Wykonuje naraz wszystkie operacje z kolejki, zapisując ich wyniki w
+ * miejscach bufora potoku, i budzi wątek rozdzielający. Kończy pracę, gdy
+ * kolejka jest pusta i ustawiono @p stopping.
+ * @param argument – wskaźnik na strukturę wątku bazy.
+ * @return Wartość @c NULL.
+ */
+static void *pipelineWork(void *argument) {
+    struct PipelineWorker *worker;
+    struct Pipeline *pipeline;
+    struct PipelineSlot *slot;
+    size_t executed, queued, index;
+
+    worker = argument;
+    pipeline = worker->pipeline;
+    executed = 0;
+    pthread_mutex_lock(&worker->mutex);
+    while (true) {
+        while (worker->queuedCount == executed && !worker->stopping)
+            pthread_cond_wait(&worker->ready, &worker->mutex);
+        if (worker->queuedCount == executed)
+            break;
+        queued = worker->queuedCount;
+        pthread_mutex_unlock(&worker->mutex);
+
+        // Wykonanie operacji, wyniki zostają w ich buforach
+        for (; executed < queued; executed++) {
+            index = worker->queue[executed % PIPELINE_SIZE];
+            slot = &pipeline->slots[index];
+            slot->result = operationExecute(pipeline->operations[index],
+                                            &slot->base, NULL,
+                                            worker->pool);
+            atomic_store_explicit(&slot->done, true, memory_order_release);
+        }
+
+        // Obudzenie wątku rozdzielającego
+        pthread_mutex_lock(&pipeline->mutex);
+        pthread_cond_signal(&pipeline->ready);
+        pthread_mutex_unlock(&pipeline->mutex);
+
+        pthread_mutex_lock(&worker->mutex);
+    }
+    pthread_mutex_unlock(&worker->mutex);
+
+    return NULL;
+}
+
+/**
+ * @brief Sprawdza, czy można rozdzielić kolejną operację.
+ * Usunięcie bazy czeka na zakończenie wszystkich wcześniejszych operacji,
+ * bo mogą one jeszcze działać na usuwanej bazie. Wymaga zablokowanego
+ * muteksu potoku.
+ * @param pipeline – wskaźnik na strukturę potoku;
+ * @param dispatched – liczba rozdzielonych operacji;
+ * @param retired – liczba zakończonych operacji.
+ * @return Wartość @c true, jeśli można rozdzielić kolejną operację, lub
+ *         wartość @c false w przeciwnym przypadku.
+ */
+static bool pipelineCanDispatch(struct Pipeline *pipeline, size_t dispatched,
+                                size_t retired) {
+    if (dispatched == pipeline->parsedCount)
+        return false;
+    return pipeline->operations[dispatched % PIPELINE_SIZE]->typeOfOperation
+           != DEL_BASE || retired == dispatched;
+}
+
+/**
+ * @brief Sprawdza, czy można zakończyć najstarszą operację.
+ * @param pipeline – wskaźnik na strukturę potoku;
+ * @param dispatched – liczba rozdzielonych operacji;
+ * @param retired – liczba zakończonych operacji.
+ * @return Wartość @c true, jeśli najstarsza rozdzielona operacja została
+ *         wykonana, lub wartość @c false w przeciwnym przypadku.
+ */
+static bool pipelineCanRetire(struct Pipeline *pipeline, size_t dispatched,
+                              size_t retired) {
+    return retired < dispatched &&
+           atomic_load_explicit(&pipeline->slots[retired % PIPELINE_SIZE].done,
+                                memory_order_acquire);
+}
+
+/**
+ * @brief Rozdziela operacje pomiędzy wątki baz.
+ * Operacje na aktualnej bazie trafiają do kolejki jej wątku, a pozostałe są
+ * wykonywane od razu. Wykonane operacje są kończone w kolejności wczytania -
+ * ich wyniki są wtedy wypisywane, więc wyjście jest takie samo, jak przy
+ * wykonywaniu kolejnym. Po pierwszej operacji zakończonej błędem nie jest
+ * wypisywana żadna kolejna (choć mogły one zostać już wykonane).
+ * @param pipeline – wskaźnik na strukturę potoku;
+ * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań;
+ * @param workers – tablica uruchomionych wątków baz;
+ * @param workersCount – liczba wątków baz;
+ * @param pool – pula wątków używanych przez operację @c NTRIV, lub @c NULL.
+ * @return Wartość @c 0, jeśli wszystkie operacje się powiodły, lub wartość
+ *         @c 1, jeśli wystąpił błąd.
+ */
+static int pipelineDispatch(struct Pipeline *pipeline,
+                            struct Dictionary *dictionary,
+                            struct PipelineWorker *workers,
+                            unsigned workersCount,
+                            struct PhoneForwardPool *pool) {
+    struct PhoneForward *phoneForward;
+    struct PipelineWorker *worker;
+    struct Operation *operation;
+    struct PipelineSlot *slot;
+    size_t dispatched, retired, parsed, index;
+
+    phoneForward = NULL;
+    dispatched = 0;
+    retired = 0;
+    pthread_mutex_lock(&pipeline->mutex);
+    while (true) {
+
+        // Zwolnienie miejsc zakończonych operacji
+        if (pipeline->executedCount != retired) {
+            pipeline->executedCount = retired;
+            pthread_cond_signal(&pipeline->executed);
+        }
+
+        // Czekanie na operację do rozdzielenia, lub zakończenia
+        while (!pipelineCanDispatch(pipeline, dispatched, retired) &&
+               !pipelineCanRetire(pipeline, dispatched, retired)) {
+            if (pipeline->finished && retired == pipeline->parsedCount) {
+                pthread_mutex_unlock(&pipeline->mutex);
+                return 0;
+            }
+            if (pipeline->waiting && retired == dispatched) {
+                pipeline->waiting = false;
+                pthread_mutex_unlock(&pipeline->mutex);
+                outputWriterFlush();
+                pthread_mutex_lock(&pipeline->mutex);
+                continue;
+            }
+            pthread_cond_wait(&pipeline->ready, &pipeline->mutex);
+        }
+        parsed = pipeline->parsedCount;
+        pthread_mutex_unlock(&pipeline->mutex);
+
+        // Rozdzielenie wczytanych operacji
+        while (dispatched < parsed) {
+            index = dispatched % PIPELINE_SIZE;
+            operation = pipeline->operations[index];
+            slot = &pipeline->slots[index];
+            if (operation->typeOfOperation == DEL_BASE && retired < dispatched)
+                break;
+
+            if (phoneForward != NULL && pipelineIsBaseOperation(operation)) {
+                slot->base = phoneForward;
+                atomic_store_explicit(&slot->done, false,
+                                      memory_order_relaxed);
+                worker = &workers[pipelineWorkerOf(phoneForward,
+                                                   workersCount)];
+                pthread_mutex_lock(&worker->mutex);
+                worker->queue[worker->queuedCount % PIPELINE_SIZE] = index;
+                worker->queuedCount++;
+                pthread_cond_signal(&worker->ready);
+                pthread_mutex_unlock(&worker->mutex);
+            } else {
+                slot->result = operationExecute(operation, &phoneForward,
+                                                dictionary, pool);
+                atomic_store_explicit(&slot->done, true,
+                                      memory_order_relaxed);
+            }
+            dispatched++;
+        }
+
+        // Zakończenie wykonanych operacji w kolejności wczytania
+        while (pipelineCanRetire(pipeline, dispatched, retired)) {
+            index = retired % PIPELINE_SIZE;
+            operation = pipeline->operations[index];
+            if (pipeline->slots[index].result != OPERATION_SUCCESS) {
+                operationPrintError(operation, pipeline->slots[index].result);
+                return 1;
+            }
+            if (operation->outputUsed > 0)
+                outputWriterWrite(operation->output, operation->outputUsed);
+            operationClean(operation);
+            retired++;
+        }
+
+        pthread_mutex_lock(&pipeline->mutex);
+    }
+}
+
+/**
+ * @brief Wykonuje operacje w wątkach baz.
+ * Uruchamia wątki baz i rozdziela pomiędzy nie operacje
+ * (@ref pipelineDispatch). Jeśli nie udało się uruchomić żadnego wątku, to
+ * wykonuje operacje przez @ref pipelineExecute.
+ * @param pipeline – wskaźnik na strukturę potoku;
+ * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań;
+ * @param workersCount – liczba wątków baz;
+ * @param pool – pula wątków używanych przez operację @c NTRIV, lub @c NULL.
+ * @return Wartość @c 0, jeśli wszystkie operacje się powiodły, lub wartość
+ *         @c 1, jeśli wystąpił błąd.
+ */
+static int pipelineExecuteSharded(struct Pipeline *pipeline,
+                                  struct Dictionary *dictionary,
+                                  unsigned workersCount,
+                                  struct PhoneForwardPool *pool) {
+    struct PipelineWorker *workers;
+    unsigned started, i;
+    int programmeOutput;
+    size_t j;
+
+    workers = malloc(workersCount * sizeof(struct PipelineWorker));
+    if (workers == NULL)
+        return pipelineExecute(pipeline, dictionary, pool);
+
+    // Uruchomienie wątków baz
+    for (started = 0; started < workersCount; started++) {
+        workers[started].queuedCount = 0;
+        workers[started].stopping = false;
+        workers[started].pipeline = pipeline;
+        workers[started].pool = pool;
+        pthread_mutex_init(&workers[started].mutex, NULL);
+        pthread_cond_init(&workers[started].ready, NULL);
+        if (pthread_create(&workers[started].thread, NULL, pipelineWork,
+                           &workers[started]) != 0) {
+            pthread_cond_destroy(&workers[started].ready);
+            pthread_mutex_destroy(&workers[started].mutex);
+            break;
+        }
+    }
+
+    // Wyniki są wypisywane przy kończeniu operacji
+    if (started > 0) {
+        for (j = 0; j < PIPELINE_SIZE; j++) {
+            pipeline->operations[j]->deferredOutput = true;
+            atomic_init(&pipeline->slots[j].done, false);
+        }
+        programmeOutput = pipelineDispatch(pipeline, dictionary, workers,
+                                           started, pool);
+    } else {
+        programmeOutput = pipelineExecute(pipeline, dictionary, pool);
+    }
+
+    // Zatrzymanie wątków baz po wykonaniu ich kolejek
+    for (i = 0; i < started; i++) {
+        pthread_mutex_lock(&workers[i].mutex);
+        workers[i].stopping = true;
+        pthread_cond_signal(&workers[i].ready);
+        pthread_mutex_unlock(&workers[i].mutex);
+    }
+    for (i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        pthread_cond_destroy(&workers[i].ready);
+        pthread_mutex_destroy(&workers[i].mutex);
+    }
+    free(workers);
+
+    return programmeOutput;
+}
+
+int pipelineRun(struct Dictionary *dictionary, struct PhoneForwardPool *pool,
+                unsigned workers) {
+    struct Pipeline *pipeline;
+    pthread_t parser;
+    int programmeOutput;
+    bool finished;
+    size_t i;
+
+    // Przygotowanie potoku
+    pipeline = malloc(sizeof(struct Pipeline));
+    if (pipeline == NULL) {
+        fprintf(stderr, "ERROR memory error\n");
+        return 1;
+    }
+    pipeline->parsedCount = 0;
+    pipeline->pendingCount = 0;
+    pipeline->executedCount = 0;
+    pipeline->waiting = false;
+    pipeline->finished = false;
+    pipeline->stopped = false;
+    pipeline->inputCharacterNumber = 0;
+    for (i = 0; i < PIPELINE_SIZE; i++)
+        pipeline->operations[i] = NULL;
+    for (i = 0; i < PIPELINE_SIZE; i++) {
+        pipeline->operations[i] = operationCreate();
+        if (pipeline->operations[i] == NULL)
+            break;
+    }
+    if (i < PIPELINE_SIZE) {
+        for (i = 0; i < PIPELINE_SIZE; i++)
+            operationDestroy(pipeline->operations[i]);
+        free(pipeline);
+        fprintf(stderr, "ERROR memory error\n");
+        return 1;
+    }
+    pthread_mutex_init(&pipeline->mutex, NULL);
+    pthread_cond_init(&pipeline->ready, NULL);
+    pthread_cond_init(&pipeline->executed, NULL);
+
+    // Wyniki opróżnia wątek wykonujący, a nie wczytujący
+    inputReaderSetFillCallback(pipelineBeforeFill, pipeline);
+
+    // Uruchomienie wątku wczytującego
+    if (pthread_create(&parser, NULL, pipelineParse, pipeline) != 0) {
+        programmeOutput = -1;
+    } else {
+        if (workers > 0)
+            programmeOutput = pipelineExecuteSharded(pipeline, dictionary,
+                                                     workers, pool);
+        else
+            programmeOutput = pipelineExecute(pipeline, dictionary, pool);
+
+        // Zatrzymanie wątku wczytującego, który może czekać na wejście
+        pthread_mutex_lock(&pipeline->mutex);
+        pipeline->stopped = true;
+        finished = pipeline->finished;
+        pthread_cond_signal(&pipeline->executed);
+        pthread_mutex_unlock(&pipeline->mutex);
+        if (!finished)
+            pthread_cancel(parser);
+        pthread_join(parser, NULL);
+        outputWriterFlush();
+    }
+    inputReaderSetFillCallback(NULL, NULL);
+
+    // Zwolnienie potoku
+    pthread_cond_destroy(&pipeline->executed);
+    pthread_cond_destroy(&pipeline->ready);
+    pthread_mutex_destroy(&pipeline->mutex);
+    for (i = 0; i < PIPELINE_SIZE; i++)
+        operationDestroy(pipeline->operations[i]);
+    free(pipeline);
+
+    return programmeOutput;
+}
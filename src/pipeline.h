@@ -0,0 +1,35 @@
+/** @file
+ * Interfejs potokowego wykonywania operacji z implementacją w
+ * @ref pipeline.c
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#ifndef TELEFONY_PIPELINE_H
+#define TELEFONY_PIPELINE_H
+
+#include "dictionary.h"
+
+/**
+ * @brief Wczytuje i wykonuje wszystkie operacje z wejścia.
+ * Działa jak pętla programu wykonująca kolejno wczytywane operacje, ale
+ * wczytywanie odbywa się w osobnym wątku, który zapisuje wczytane operacje do
+ * ograniczonego bufora cyklicznego. Wątek wywołujący wykonuje je w kolejności
+ * wczytania. Po pierwszej operacji zakończonej błędem nie jest wykonywana ani
+ * wypisywana żadna kolejna.
+ * Jeśli @p workers jest dodatnie, to operacje na różnych bazach są wykonywane
+ * równolegle w @p workers wątkach baz, a wyniki są wypisywane w kolejności
+ * wczytania operacji.
+ * @param dictionary – wskaźnik na słownik przechowujący bazy przekierowań;
+ * @param pool – pula wątków używanych przez operację @c NTRIV, lub @c NULL;
+ * @param workers – liczba wątków baz, lub @c 0, jeśli wszystkie operacje ma
+ *                  wykonywać jeden wątek.
+ * @return Wartość @c 0, jeśli wszystkie operacje się powiodły, wartość @c 1,
+ *         jeśli wystąpił błąd, lub wartość @c -1, jeśli nie udało się
+ *         uruchomić wątku wczytującego (wejście nie zostało wtedy ruszone).
+ */
+int pipelineRun(struct Dictionary *dictionary, struct PhoneForwardPool *pool,
+                unsigned workers);
+
+#endif //TELEFONY_PIPELINE_H
@@ -0,0 +1,99 @@
+/** @file
+ * Implementacja areny elementów stałego rozmiaru z interfejsem w pliku
+ * @ref slab_arena.h
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "slab_arena.h"
+
+/**
+ * Początkowy rozmiar tablicy bloków
+ */
+#define SLABS_INITIAL_CAPACITY 4
+
+void slabArenaInit(struct SlabArena *arena, size_t elementSize) {
+    arena->slabs = NULL;
+    arena->elementSize = elementSize;
+    arena->slabsCount = 0;
+    arena->slabsCapacity = 0;
+    // Indeks SLAB_ARENA_NULL jest od początku zajęty
+    arena->used = 1;
+    arena->freeList = SLAB_ARENA_NULL;
+}
+
+void slabArenaDestroy(struct SlabArena *arena) {
+    uint32_t i;
+
+    // Zwolnienie kolejnych bloków
+    for (i = 0; i < arena->slabsCount; i++)
+        free(arena->slabs[i]);
+    free(arena->slabs);
+
+    // Przywrócenie pustej areny
+    slabArenaInit(arena, arena->elementSize);
+}
+
+/**
+ * @brief Dodaje blok do areny.
+ * @param[in, out] arena – wskaźnik na arenę.
+ * @return Wartość @c true, jeśli udało się dodać blok, lub wartość @c false,
+ *         gdy nie udało się zaalokować pamięci.
+ */
+bool slabArenaGrow(struct SlabArena *arena) {
+    char **newSlabs;
+    char *newSlab;
+    uint32_t newCapacity;
+
+    // Powiększenie tablicy bloków dwukrotnie, jeśli zajdzie taka potrzeba
+    if (arena->slabsCount == arena->slabsCapacity) {
+        newCapacity = arena->slabsCapacity == 0 ? SLABS_INITIAL_CAPACITY
+                                                : 2 * arena->slabsCapacity;
+        newSlabs = realloc(arena->slabs, newCapacity * sizeof(char *));
+        if (newSlabs == NULL)
+            return false;
+        arena->slabs = newSlabs;
+        arena->slabsCapacity = newCapacity;
+    }
+
+    // Zaalokowanie nowego bloku
+    newSlab = malloc((SLAB_ARENA_SLAB_MASK + 1) * arena->elementSize);
+    if (newSlab == NULL)
+        return false;
+    arena->slabs[arena->slabsCount++] = newSlab;
+    return true;
+}
+
+uint32_t slabArenaAlloc(struct SlabArena *arena) {
+    uint32_t index;
+
+    if (arena->freeList != SLAB_ARENA_NULL) {
+        // Ponowne użycie zwolnionego elementu
+        index = arena->freeList;
+        memcpy(&arena->freeList, slabArenaGet(arena, index), sizeof(uint32_t));
+    } else {
+        // Przydzielenie nowego elementu, w razie potrzeby w nowym bloku
+        if (arena->used == UINT32_MAX)
+            return SLAB_ARENA_NULL;
+        if ((arena->used >> SLAB_ARENA_SLAB_BITS) == arena->slabsCount &&
+            !slabArenaGrow(arena))
+            return SLAB_ARENA_NULL;
+        index = arena->used++;
+    }
+
+    memset(slabArenaGet(arena, index), 0, arena->elementSize);
+    return index;
+}
+
+void slabArenaFree(struct SlabArena *arena, uint32_t index) {
+    if (index == SLAB_ARENA_NULL)
+        return;
+
+    // Dopisanie elementu na początek listy wolnych elementów
+    memcpy(slabArenaGet(arena, index), &arena->freeList, sizeof(uint32_t));
+    arena->freeList = index;
+}
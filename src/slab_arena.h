@@ -0,0 +1,120 @@
+/** @file
+ * Interfejs i deklaracja areny elementów stałego rozmiaru przydzielanych w
+ * blokach z implementacją w pliku @ref slab_arena.c
+ *
+ * @author Witalis Domitrz <witekdomitrz@gmail.com>
+ * @date 17.10.2026
+ */
+
+#ifndef TELEFONY_SLAB_ARENA_H
+#define TELEFONY_SLAB_ARENA_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Logarytm o podstawie 2 z liczby elementów w jednym bloku areny
+ */
+#define SLAB_ARENA_SLAB_BITS 8
+
+/**
+ * Maska wyznaczająca pozycję elementu w jego bloku
+ */
+#define SLAB_ARENA_SLAB_MASK ((1u << SLAB_ARENA_SLAB_BITS) - 1)
+
+/**
+ * Indeks niebędący indeksem żadnego elementu areny
+ */
+#define SLAB_ARENA_NULL 0
+
+/**
+ * @brief Arena elementów stałego rozmiaru.
+ * Elementy są przechowywane w blokach po @c 2^SLAB_ARENA_SLAB_BITS sztuk i
+ * identyfikowane 32-bitowymi indeksami. Zwolnione elementy trafiają na listę
+ * wolnych elementów i są używane ponownie. Indeks @ref SLAB_ARENA_NULL nigdy
+ * nie jest przydzielany.
+ */
+struct SlabArena {
+    /**@{*/
+
+    char **slabs;
+    /**<
+     * Tablica wskaźników na kolejne bloki.
+     */
+
+    size_t elementSize;
+    /**<
+     * Rozmiar jednego elementu w bajtach.
+     */
+
+    uint32_t slabsCount;
+    /**<
+     * Liczba zaalokowanych bloków.
+     */
+
+    uint32_t slabsCapacity;
+    /**<
+     * Rozmiar tablicy @p slabs.
+     */
+
+    uint32_t used;
+    /**<
+     * Liczba indeksów, które były kiedykolwiek przydzielone (łącznie z
+     * @ref SLAB_ARENA_NULL).
+     */
+
+    uint32_t freeList;
+    /**<
+     * Indeks pierwszego zwolnionego elementu, lub @ref SLAB_ARENA_NULL.
+     */
+
+    /**@}*/
+};
+
+/**
+ * @brief Inicjalizuje arenę.
+ * Ustawia pustą arenę elementów rozmiaru @p elementSize. Nie alokuje pamięci.
+ * @param[out] arena – wskaźnik na inicjalizowaną arenę;
+ * @param elementSize – rozmiar elementu, nie mniejszy niż @c sizeof(uint32_t).
+ */
+void slabArenaInit(struct SlabArena *arena, size_t elementSize);
+
+/**
+ * @brief Zwalnia pamięć areny.
+ * Zwalnia wszystkie bloki areny za jednym razem, niezależnie od liczby
+ * przydzielonych elementów, i ustawia ją na pustą.
+ * @param[in, out] arena – wskaźnik na arenę.
+ */
+void slabArenaDestroy(struct SlabArena *arena);
+
+/**
+ * @brief Przydziela element.
+ * Przydziela nowy element z areny. Zawartość elementu jest wyzerowana.
+ * @param[in, out] arena – wskaźnik na arenę.
+ * @return Indeks nowego elementu, lub @ref SLAB_ARENA_NULL, gdy nie udało się
+ *         zaalokować pamięci.
+ */
+uint32_t slabArenaAlloc(struct SlabArena *arena);
+
+/**
+ * @brief Zwalnia element.
+ * Oddaje element o indeksie @p index do areny. Nic nie robi dla
+ * @ref SLAB_ARENA_NULL.
+ * @param[in, out] arena – wskaźnik na arenę;
+ * @param index – indeks zwalnianego elementu.
+ */
+void slabArenaFree(struct SlabArena *arena, uint32_t index);
+
+/**
+ * @brief Udostępnia element.
+ * @param arena – wskaźnik na arenę;
+ * @param index – indeks przydzielonego elementu.
+ * @return Wskaźnik na element. Pozostaje ważny do zwolnienia areny.
+ */
+static inline void *slabArenaGet(struct SlabArena const *arena,
+                                 uint32_t index) {
+    return arena->slabs[index >> SLAB_ARENA_SLAB_BITS] +
+           (size_t) (index & SLAB_ARENA_SLAB_MASK) * arena->elementSize;
+}
+
+#endif //TELEFONY_SLAB_ARENA_H